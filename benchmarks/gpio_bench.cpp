@@ -0,0 +1,173 @@
+// GPIO throughput benchmark: compares the lock-free port table against the
+// previous unordered_map + global mutex implementation, single- and
+// multi-threaded, and measures the cost of logic analyzer capture.
+#include "sdk/gpio.hpp"
+#include "sdk/logic_analyzer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <mutex>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+namespace legacy {
+// Verbatim model of the original gpio.cpp storage, kept for comparison
+struct PinConfig {
+  PinMode mode;
+  PinState state;
+};
+
+std::unordered_map<uint32_t, PinConfig> pin_configs;
+std::mutex gpio_mutex;
+
+uint32_t makePinId(uint8_t port, uint8_t pin) {
+  return (static_cast<uint32_t>(port) << 8) | pin;
+}
+
+void configurePin(uint8_t port, uint8_t pin, PinMode mode) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  pin_configs[makePinId(port, pin)] = PinConfig{mode, PinState::LOW};
+}
+
+bool writePin(uint8_t port, uint8_t pin, PinState state) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  auto it = pin_configs.find(makePinId(port, pin));
+  if (it == pin_configs.end() || it->second.mode != PinMode::OUTPUT)
+    return false;
+  it->second.state = state;
+  return true;
+}
+
+PinState readPin(uint8_t port, uint8_t pin) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  auto it = pin_configs.find(makePinId(port, pin));
+  return it == pin_configs.end() ? PinState::LOW : it->second.state;
+}
+
+bool togglePin(uint8_t port, uint8_t pin) {
+  std::lock_guard<std::mutex> lock(gpio_mutex);
+  auto it = pin_configs.find(makePinId(port, pin));
+  if (it == pin_configs.end() || it->second.mode != PinMode::OUTPUT)
+    return false;
+  it->second.state =
+      (it->second.state == PinState::HIGH) ? PinState::LOW : PinState::HIGH;
+  return true;
+}
+} // namespace legacy
+
+namespace {
+constexpr uint64_t kOpsPerThread = 2000000;
+constexpr uint8_t kPinsPerPort = 16;
+
+// Each thread bit-bangs its own port: write, read back, toggle
+double run(unsigned threads, void (*op)(uint8_t port, uint64_t i)) {
+  std::atomic<bool> go{false};
+  std::vector<std::thread> workers;
+  for (unsigned t = 0; t < threads; ++t) {
+    workers.emplace_back([&go, op, t] {
+      while (!go.load(std::memory_order_acquire)) {
+      }
+      for (uint64_t i = 0; i < kOpsPerThread; ++i) {
+        op(static_cast<uint8_t>(t), i);
+      }
+    });
+  }
+
+  auto start = std::chrono::steady_clock::now();
+  go.store(true, std::memory_order_release);
+  for (auto &w : workers) {
+    w.join();
+  }
+  std::chrono::duration<double> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return threads * kOpsPerThread / elapsed.count();
+}
+
+void legacyOp(uint8_t port, uint64_t i) {
+  uint8_t pin = i % kPinsPerPort;
+  switch (i % 3) {
+  case 0:
+    legacy::writePin(port, pin, PinState::HIGH);
+    break;
+  case 1:
+    legacy::readPin(port, pin);
+    break;
+  default:
+    legacy::togglePin(port, pin);
+    break;
+  }
+}
+
+void gpioOp(uint8_t port, uint64_t i) {
+  uint8_t pin = i % kPinsPerPort;
+  switch (i % 3) {
+  case 0:
+    GPIO::writePin(port, pin, PinState::HIGH);
+    break;
+  case 1:
+    GPIO::readPin(port, pin);
+    break;
+  default:
+    GPIO::togglePin(port, pin);
+    break;
+  }
+}
+// Nanoseconds per toggle, each toggle being one transition
+double toggleCost(uint64_t toggles) {
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < toggles; ++i) {
+    GPIO::togglePin(0, 0);
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  return elapsed.count() / toggles;
+}
+
+void benchmarkCapture() {
+  constexpr uint64_t kToggles = 500000;
+  const char *filename = "gpio_bench_capture.vcd";
+
+  double plain = toggleCost(kToggles);
+  LogicAnalyzer::start(filename, kToggles);
+  double captured = toggleCost(kToggles);
+  LogicAnalyzer::stop();
+  std::remove(filename);
+
+  auto stats = LogicAnalyzer::getStats();
+  std::printf("\ncapture overhead: %.1f ns/transition (%.1f -> %.1f ns), "
+              "%llu captured, %llu dropped\n",
+              captured - plain, plain, captured,
+              static_cast<unsigned long long>(stats.captured),
+              static_cast<unsigned long long>(stats.dropped));
+}
+} // namespace
+
+int main() {
+  unsigned maxThreads = std::max(4u, std::thread::hardware_concurrency());
+
+  GPIO::initialize(GPIOConfig{static_cast<uint8_t>(maxThreads), kPinsPerPort,
+                              true, true, true});
+  for (unsigned port = 0; port < maxThreads; ++port) {
+    for (uint8_t pin = 0; pin < kPinsPerPort; ++pin) {
+      legacy::configurePin(port, pin, PinMode::OUTPUT);
+      GPIO::configurePin(port, pin, PinMode::OUTPUT);
+    }
+  }
+
+  std::printf("%-8s %18s %18s %8s\n", "threads", "before (ops/s)",
+              "after (ops/s)", "speedup");
+  for (unsigned threads = 1; threads <= maxThreads; threads *= 2) {
+    double before = run(threads, legacyOp);
+    double after = run(threads, gpioOp);
+    std::printf("%-8u %18.0f %18.0f %7.1fx\n", threads, before, after,
+                after / before);
+  }
+
+  benchmarkCapture();
+  return 0;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+// Interrupt trigger benchmark: compares the flat handler table against the
+// original std::map + global mutex + std::function queue implementation and
+// counts heap allocations on the trigger and dispatch paths. Triggers are
+// measured twice: back to back, where most of them coalesce into a pending
+// line, and one at a time, where every trigger is dispatched.
+#include "sdk/interrupt.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <functional>
+#include <map>
+#include <mutex>
+#include <new>
+#include <queue>
+#include <string>
+#include <thread>
+
+
+using namespace ti_sdk;
+
+namespace {
+std::atomic<uint64_t> allocations{0};
+} // namespace
+
+// Count every heap allocation in the process
+void *operator new(size_t size) {
+  allocations.fetch_add(1, std::memory_order_relaxed);
+  if (void *p = std::malloc(size ? size : 1))
+    return p;
+  throw std::bad_alloc();
+}
+
+void operator delete(void *p) noexcept { std::free(p); }
+void operator delete(void *p, size_t) noexcept { std::free(p); }
+
+namespace legacy {
+// Verbatim model of the original interrupt.hpp trigger path. The debug
+// message is formatted but not printed, to keep the console out of the
+// measurement.
+std::map<uint32_t, std::function<void()>> handlers;
+std::queue<std::function<void()>> pendingInterrupts;
+std::mutex mutex;
+std::string lastMessage;
+
+uint32_t makeInterruptId(InterruptType type, uint8_t source) {
+  return (static_cast<uint32_t>(type) << 8) | source;
+}
+
+void attachInterrupt(InterruptType type, uint8_t source,
+                     std::function<void()> handler) {
+  std::lock_guard<std::mutex> lock(mutex);
+  handlers[makeInterruptId(type, source)] = handler;
+}
+
+void triggerInterrupt(InterruptType type, uint8_t source) {
+  std::lock_guard<std::mutex> lock(mutex);
+  uint32_t id = makeInterruptId(type, source);
+  auto it = handlers.find(id);
+  if (it != handlers.end()) {
+    pendingInterrupts.push(it->second);
+    lastMessage = "Interrupt triggered for type: " +
+                  std::to_string(static_cast<int>(type)) +
+                  ", source: " + std::to_string(source);
+  }
+}
+
+// Run the oldest queued handler like the original processing thread, but
+// inline and without its 1 ms sleep, so this is a lower bound
+void dispatchOne() {
+  std::function<void()> handler;
+  {
+    std::lock_guard<std::mutex> lock(mutex);
+    handler = pendingInterrupts.front();
+    pendingInterrupts.pop();
+  }
+  handler();
+}
+} // namespace legacy
+
+namespace {
+constexpr uint64_t kTriggers = 1000000;
+// Each of these waits for a worker wakeup
+constexpr uint64_t kDispatchedTriggers = 100000;
+constexpr uint8_t kSources = 8;
+
+// Handler calls so far, and how many waitDispatched expects
+const std::atomic<uint64_t> *handledCount = nullptr;
+uint64_t expectedHandled = 0;
+
+struct Result {
+  double nsPerTrigger;
+  double allocationsPerTrigger;
+};
+
+// Trigger count times, calling settle (if any) after every trigger
+Result run(void (*trigger)(InterruptType, uint8_t), uint64_t count,
+           void (*settle)() = nullptr) {
+  uint64_t before = allocations.load();
+  auto start = std::chrono::steady_clock::now();
+  for (uint64_t i = 0; i < count; ++i) {
+    trigger(InterruptType::TIMER, static_cast<uint8_t>(i % kSources));
+    if (settle)
+      settle();
+  }
+  std::chrono::duration<double, std::nano> elapsed =
+      std::chrono::steady_clock::now() - start;
+  uint64_t allocated = allocations.load() - before;
+  return Result{elapsed.count() / count,
+                static_cast<double>(allocated) / count};
+}
+
+void triggerManager(InterruptType type, uint8_t source) {
+  InterruptManager::getInstance().triggerInterrupt(type, source);
+}
+
+// Wait until a worker has run the handler of the last trigger
+void waitDispatched() {
+  ++expectedHandled;
+  while (handledCount->load(std::memory_order_acquire) < expectedHandled)
+    std::this_thread::yield();
+}
+} // namespace
+
+int main() {
+  // Handlers capture three pointers, more than std::function stores inline
+  std::atomic<uint64_t> handled{0};
+  handledCount = &handled;
+  uint64_t calls = 0;
+  uint64_t lastSource = 0;
+  auto &interrupts = InterruptManager::getInstance();
+  for (uint8_t source = 0; source < kSources; ++source) {
+    auto handler = [&handled, &calls, &lastSource] {
+      handled.fetch_add(1, std::memory_order_release);
+      ++calls;
+      ++lastSource;
+    };
+    legacy::attachInterrupt(InterruptType::TIMER, source, handler);
+    interrupts.attachInterrupt(InterruptType::TIMER, source, handler);
+  }
+
+  Result before = run(legacy::triggerInterrupt, kTriggers);
+  legacy::pendingInterrupts = {};
+  Result beforeDispatched = run(legacy::triggerInterrupt, kDispatchedTriggers,
+                                legacy::dispatchOne);
+
+  // Dispatcher allocations are counted too, as they run concurrently
+  interrupts.start();
+  uint64_t handledBefore = handled.load();
+  Result after = run(triggerManager, kTriggers);
+  // Let the dispatcher drain the last pending lines
+  std::this_thread::sleep_for(std::chrono::milliseconds(10));
+  uint64_t coalescedHandled = handled.load() - handledBefore;
+  expectedHandled = handled.load();
+  Result afterDispatched =
+      run(triggerManager, kDispatchedTriggers, waitDispatched);
+  interrupts.stop();
+
+  std::printf("%-8s %27s %27s\n", "", "coalesced", "dispatched");
+  std::printf("%-8s %14s %12s %14s %12s\n", "", "ns/trigger", "allocs",
+              "ns/trigger", "allocs");
+  std::printf("%-8s %14.1f %12.2f %14.1f %12.2f\n", "before",
+              before.nsPerTrigger, before.allocationsPerTrigger,
+              beforeDispatched.nsPerTrigger,
+              beforeDispatched.allocationsPerTrigger);
+  std::printf("%-8s %14.1f %12.2f %14.1f %12.2f\n", "after",
+              after.nsPerTrigger, after.allocationsPerTrigger,
+              afterDispatched.nsPerTrigger,
+              afterDispatched.allocationsPerTrigger);
+  std::printf("\ncoalesced: %llu triggers, %llu dispatched\n",
+              static_cast<unsigned long long>(kTriggers),
+              static_cast<unsigned long long>(coalescedHandled));
+  std::printf("dispatched: %llu triggers, each waited for its handler "
+              "(before: handler run inline, without the original 1 ms "
+              "sleep)\n",
+              static_cast<unsigned long long>(kDispatchedTriggers));
+  return after.allocationsPerTrigger == 0 &&
+                 afterDispatched.allocationsPerTrigger == 0
+             ? 0
+             : 1;
+}
\ No newline at end of file
@@ -1,9 +1,24 @@
 #include "sdk/adc.hpp"
+#include "sdk/adc_trace.hpp"
+#include "sdk/frame_decoder.hpp"
 #include "sdk/gpio.hpp"
+#include "sdk/interrupt.hpp"
+#include "sdk/logic_analyzer.hpp"
+#include "sdk/stimulus.hpp"
 #include "sdk/uart.hpp"
+#include "sdk/uart_replay.hpp"
+#ifdef __linux__
+#include "sdk/uart_pty_bridge.hpp"
+#endif
+#include "sdk/waveform.hpp"
 #include "shell/cli_manager.hpp"
+#include "web/dashboard.hpp"
+#include <algorithm>
+#include <cctype>
 #include <iomanip>
 #include <iostream>
+#include <iterator>
+#include <numeric>
 #include <sstream>
 
 
@@ -27,6 +42,90 @@ bool parsePinArgs(const std::vector<std::string> &args, uint8_t &port,
   }
 }
 
+// Interrupt type names used by the interrupt commands
+const char *const kInterruptTypeNames[] = {
+    "gpio-rising", "gpio-falling", "gpio-change", "timer",
+    "adc-complete", "uart-rx", "uart-tx", "adc-window"};
+static_assert(std::size(kInterruptTypeNames) == kInterruptTypeCount,
+              "one name per interrupt type");
+
+// Helper function to parse interrupt type and source arguments
+bool parseInterruptArgs(const std::vector<std::string> &args,
+                        InterruptType &type, uint8_t &source) {
+  if (args.size() < 2) {
+    std::cout << "Error: Missing interrupt type and source arguments\n";
+    return false;
+  }
+
+  auto name = std::find(std::begin(kInterruptTypeNames),
+                        std::end(kInterruptTypeNames), args[0]);
+  if (name == std::end(kInterruptTypeNames)) {
+    std::cout << "Error: Unknown interrupt type\n";
+    return false;
+  }
+  type = static_cast<InterruptType>(name - std::begin(kInterruptTypeNames));
+
+  try {
+    source = std::stoi(args[1]);
+    return true;
+  } catch (const std::exception &) {
+    std::cout << "Error: Invalid interrupt source\n";
+    return false;
+  }
+}
+
+// Helper function to join UART data arguments, decoding \n, \r, \t, \\ and
+// \xHH escapes
+bool parseUartData(const std::vector<std::string> &args, size_t first,
+                   std::string &data) {
+  std::string text;
+  for (size_t i = first; i < args.size(); ++i) {
+    if (i > first)
+      text += ' ';
+    text += args[i];
+  }
+
+  data.clear();
+  for (size_t i = 0; i < text.size(); ++i) {
+    if (text[i] != '\\' || i + 1 == text.size()) {
+      data += text[i];
+      continue;
+    }
+    char c = text[++i];
+    if (c == 'n')
+      data += '\n';
+    else if (c == 'r')
+      data += '\r';
+    else if (c == 't')
+      data += '\t';
+    else if (c == '\\')
+      data += '\\';
+    else if (c == 'x' && i + 2 < text.size() &&
+             std::isxdigit(static_cast<unsigned char>(text[i + 1])) &&
+             std::isxdigit(static_cast<unsigned char>(text[i + 2]))) {
+      data += static_cast<char>(std::stoi(text.substr(i + 1, 2), nullptr, 16));
+      i += 2;
+    } else {
+      std::cout << "Error: Invalid escape sequence \\" << c << "\n";
+      return false;
+    }
+  }
+  return true;
+}
+
+// Helper function to format UART data, escaping non-printable bytes
+std::string formatUartData(const uint8_t *data, size_t length) {
+  std::ostringstream text;
+  for (size_t i = 0; i < length; ++i) {
+    if (std::isprint(data[i]))
+      text << static_cast<char>(data[i]);
+    else
+      text << "\\x" << std::hex << std::setw(2) << std::setfill('0')
+           << static_cast<int>(data[i]);
+  }
+  return text.str();
+}
+
 int main() {
   // Initialize subsystems
   if (!GPIO::initialize()) {
@@ -34,9 +133,13 @@ int main() {
     return 1;
   }
 
-  if (!UART::initialize(115200)) {
-    std::cerr << "Failed to initialize UART subsystem\n";
-    return 1;
+  for (uint8_t channel = 0; channel < UART::getConfig().numChannels;
+       ++channel) {
+    if (!UART::initialize(channel, 115200)) {
+      std::cerr << "Failed to initialize UART channel "
+                << static_cast<int>(channel) << "\n";
+      return 1;
+    }
   }
 
   if (!ADC::initialize()) {
@@ -44,6 +147,8 @@ int main() {
     return 1;
   }
 
+  InterruptManager::getInstance().start();
+
   shell::CLIManager cli;
 
   // Register GPIO commands
@@ -129,6 +234,514 @@ int main() {
         return true;
       });
 
+  cli.registerCommand(
+      "gpio-port-write",
+      "Write masked port pins: gpio-port-write <port> <mask> <value>",
+      [](const auto &args) {
+        if (args.size() < 3) {
+          std::cout << "Error: Missing port, mask and value arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t port = std::stoi(args[0]);
+          uint32_t mask = std::stoul(args[1], nullptr, 0);
+          uint32_t value = std::stoul(args[2], nullptr, 0);
+
+          if (!GPIO::writePortMasked(port, mask, value)) {
+            std::cout << "Error: Failed to write to port (all masked pins "
+                         "must be outputs)\n";
+            return false;
+          }
+
+          std::cout << "Port written successfully\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid port, mask or value\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "gpio-port-read", "Read all pins of a GPIO port: gpio-port-read <port>",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing port argument\n";
+          return false;
+        }
+
+        try {
+          uint8_t port = std::stoi(args[0]);
+          std::cout << "Port value: 0x" << std::hex << std::setw(8)
+                    << std::setfill('0') << GPIO::readPort(port) << std::dec
+                    << std::setfill(' ') << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid port number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "gpio-pwm",
+      "Drive PWM on a GPIO pin: gpio-pwm <port> <pin> <frequency-hz> <duty-%>",
+      [](const auto &args) {
+        uint8_t port, pin;
+        if (!parsePinArgs(args, port, pin))
+          return false;
+
+        if (args.size() < 4) {
+          std::cout << "Error: Missing frequency and duty cycle arguments\n";
+          return false;
+        }
+
+        try {
+          double frequency = std::stod(args[2]);
+          double duty = std::stod(args[3]) / 100.0;
+
+          if (!WaveformGenerator::startPWM(port, pin, frequency, duty)) {
+            std::cout << "Error: Failed to start PWM (pin must be an output, "
+                         "duty 0-100%)\n";
+            return false;
+          }
+
+          std::cout << "PWM started\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid frequency or duty cycle\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "gpio-pattern",
+      "Clock a bit pattern out of a GPIO pin: gpio-pattern <port> <pin> "
+      "<bit-rate> <bits> [once]",
+      [](const auto &args) {
+        uint8_t port, pin;
+        if (!parsePinArgs(args, port, pin))
+          return false;
+
+        if (args.size() < 4) {
+          std::cout << "Error: Missing bit rate and pattern arguments\n";
+          return false;
+        }
+
+        std::vector<bool> bits;
+        for (char c : args[3]) {
+          if (c != '0' && c != '1') {
+            std::cout << "Error: Pattern must consist of 0 and 1\n";
+            return false;
+          }
+          bits.push_back(c == '1');
+        }
+        bool loop = !(args.size() > 4 && args[4] == "once");
+
+        try {
+          double bitRate = std::stod(args[2]);
+          if (!WaveformGenerator::startPattern(port, pin, bitRate, bits,
+                                               loop)) {
+            std::cout << "Error: Failed to start pattern (pin must be an "
+                         "output)\n";
+            return false;
+          }
+
+          std::cout << "Pattern started\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid bit rate\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "gpio-wave-stop",
+      "Stop the waveform on a GPIO pin: gpio-wave-stop <port> <pin>",
+      [](const auto &args) {
+        uint8_t port, pin;
+        if (!parsePinArgs(args, port, pin))
+          return false;
+
+        if (!WaveformGenerator::stop(port, pin)) {
+          std::cout << "Error: No waveform running on pin\n";
+          return false;
+        }
+
+        std::cout << "Waveform stopped\n";
+        return true;
+      });
+
+  cli.registerCommand(
+      "gpio-capture",
+      "Capture GPIO transitions to a VCD file: gpio-capture start <file> "
+      "[capacity] | stop",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing start/stop argument\n";
+          return false;
+        }
+
+        if (args[0] == "stop") {
+          if (!LogicAnalyzer::stop()) {
+            std::cout << "Error: No capture running\n";
+            return false;
+          }
+          auto stats = LogicAnalyzer::getStats();
+          std::cout << "Capture stopped: " << stats.captured
+                    << " transitions written, " << stats.dropped
+                    << " dropped\n";
+          return true;
+        }
+
+        if (args[0] != "start" || args.size() < 2) {
+          std::cout << "Error: Usage: gpio-capture start <file> [capacity]\n";
+          return false;
+        }
+
+        try {
+          size_t capacity = args.size() > 2 ? std::stoul(args[2]) : 1 << 16;
+          if (!LogicAnalyzer::start(args[1], capacity)) {
+            std::cout << "Error: Failed to start capture\n";
+            return false;
+          }
+
+          std::cout << "Capturing to " << args[1] << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid capacity\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "gpio-stimulus",
+      "Replay recorded stimulus onto GPIO inputs: gpio-stimulus <file> "
+      "[fast] | stop",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing file argument\n";
+          return false;
+        }
+
+        if (args[0] == "stop") {
+          StimulusPlayer::stop();
+          auto stats = StimulusPlayer::getStats();
+          std::cout << "Stimulus stopped: " << stats.records
+                    << " updates applied, " << stats.rejected
+                    << " rejected\n";
+          return true;
+        }
+
+        bool fast = args.size() > 1 && args[1] == "fast";
+        if (!StimulusPlayer::start(args[0], fast)) {
+          std::cout << "Error: Failed to start stimulus replay\n";
+          return false;
+        }
+
+        std::cout << "Replaying " << args[0] << "\n";
+        return true;
+      });
+
+  // Register UART commands
+  cli.registerCommand(
+      "uart-write", "Transmit data on a UART channel: uart-write <ch> <data>",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and data arguments\n";
+          return false;
+        }
+
+        std::string data;
+        if (!parseUartData(args, 1, data))
+          return false;
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          size_t written = UART::writeBuffer(
+              channel, reinterpret_cast<const uint8_t *>(data.data()),
+              data.size());
+          if (written == 0 && !data.empty()) {
+            std::cout << "Error: Failed to write to UART channel\n";
+            return false;
+          }
+
+          std::cout << written << " of " << data.size()
+                    << " bytes queued for transmit\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "uart-inject",
+      "Deliver data to a UART channel's receiver: uart-inject <ch> <data>",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and data arguments\n";
+          return false;
+        }
+
+        std::string data;
+        if (!parseUartData(args, 1, data))
+          return false;
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          size_t received = UART::injectRx(
+              channel, reinterpret_cast<const uint8_t *>(data.data()),
+              data.size());
+          if (received == 0 && !data.empty()) {
+            std::cout << "Error: Failed to inject into UART channel\n";
+            return false;
+          }
+
+          std::cout << received << " of " << data.size()
+                    << " bytes received\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "uart-read",
+      "Read received (or transmitted) data: uart-read <ch> [tx]",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing channel argument\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          if (channel >= UART::getConfig().numChannels) {
+            std::cout << "Error: Invalid channel number\n";
+            return false;
+          }
+
+          // drainTx has a single consumer, which may be a pty bridge
+          bool tx = args.size() > 1 && args[1] == "tx";
+          if (tx && !UART::claimTx(channel)) {
+            std::cout << "Error: TX of channel " << static_cast<int>(channel)
+                      << " is drained by a pty bridge\n";
+            return false;
+          }
+          uint8_t buffer[256];
+          size_t total = 0;
+          std::cout << (tx ? "TX" : "RX") << " data: ";
+          while (size_t count =
+                     tx ? UART::drainTx(channel, buffer, sizeof(buffer))
+                        : UART::readBuffer(channel, buffer, sizeof(buffer))) {
+            std::cout << formatUartData(buffer, count);
+            total += count;
+          }
+          if (tx)
+            UART::releaseTx(channel);
+
+          auto stats = UART::getStats(channel);
+          std::cout << "\n"
+                    << total << " bytes, " << stats.txOverflows
+                    << " TX overflows, " << stats.rxOverflows
+                    << " RX overflows\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "uart-timing",
+      "Pace a UART channel at its baud rate: uart-timing <ch> on [8N1] | off",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and on/off arguments\n";
+          return false;
+        }
+
+        uint8_t channel;
+        try {
+          channel = std::stoi(args[0]);
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+
+        if (args[1] == "off") {
+          UART::disableTiming(channel);
+          std::cout << "UART timing disabled\n";
+          return true;
+        }
+
+        UARTFrameFormat format;
+        if (args.size() > 2) {
+          const auto &spec = args[2];
+          if (spec.size() != 3 || spec[0] < '5' || spec[0] > '8' ||
+              (spec[2] != '1' && spec[2] != '2') ||
+              std::string("NEO").find(spec[1]) == std::string::npos) {
+            std::cout << "Error: Invalid frame format, e.g. 8N1 or 7E2\n";
+            return false;
+          }
+          format.dataBits = spec[0] - '0';
+          format.parity = spec[1] == 'E'   ? UARTParity::EVEN
+                          : spec[1] == 'O' ? UARTParity::ODD
+                                           : UARTParity::NONE;
+          format.stopBits = spec[2] - '0';
+        }
+
+        if (args[1] != "on" || !UART::enableTiming(channel, format)) {
+          std::cout << "Error: Failed to enable UART timing\n";
+          return false;
+        }
+
+        std::cout << "UART timing enabled\n";
+        return true;
+      });
+
+  cli.registerCommand(
+      "uart-decode",
+      "Print frames seen on a UART channel: uart-decode <ch> <rx|tx> "
+      "<line|slip|cobs|off>",
+      [](const auto &args) {
+        if (args.size() < 3) {
+          std::cout << "Error: Missing channel, direction and framing "
+                       "arguments\n";
+          return false;
+        }
+
+        uint8_t channel;
+        try {
+          channel = std::stoi(args[0]);
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+
+        if (args[1] != "rx" && args[1] != "tx") {
+          std::cout << "Error: Direction must be rx or tx\n";
+          return false;
+        }
+        auto direction =
+            args[1] == "rx" ? UARTDirection::RX : UARTDirection::TX;
+
+        const auto &framing = args[2];
+        if (framing == "off") {
+          if (!UART::setDecoder(channel, direction, nullptr)) {
+            std::cout << "Error: Invalid channel number\n";
+            return false;
+          }
+          std::cout << "Decoder removed\n";
+          return true;
+        }
+
+        FramingMode mode;
+        if (framing == "line")
+          mode = FramingMode::LINE;
+        else if (framing == "slip")
+          mode = FramingMode::SLIP;
+        else if (framing == "cobs")
+          mode = FramingMode::COBS;
+        else {
+          std::cout << "Error: Invalid framing. Valid framings are: line, "
+                       "slip, cobs, off\n";
+          return false;
+        }
+
+        std::string label = "[uart" + std::to_string(channel) + " " +
+                            args[1] + "] ";
+        auto decoder = std::make_shared<FrameDecoder>(
+            mode, [channel, label](const uint8_t *data, size_t size) {
+              std::string text = formatUartData(data, size);
+              std::cout << label << text << "\n";
+              web::Dashboard::getInstance().updateUART(channel, text + "\n");
+            });
+        if (!UART::setDecoder(channel, direction, decoder)) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+
+        std::cout << "Decoding " << framing << " frames\n";
+        return true;
+      });
+
+  cli.registerCommand(
+      "uart-replay",
+      "Replay a capture into a UART receiver: uart-replay <ch> <file> [timed] "
+      "| <ch> stop",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and file arguments\n";
+          return false;
+        }
+
+        uint8_t channel;
+        try {
+          channel = std::stoi(args[0]);
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+
+        if (args[1] == "stop") {
+          UARTReplay::stop(channel);
+          auto stats = UARTReplay::getStats(channel);
+          std::cout << "Replay stopped: " << stats.bytes << " bytes in "
+                    << stats.records << " records delivered\n";
+          return true;
+        }
+
+        bool timed = args.size() > 2 && args[2] == "timed";
+        if (!UARTReplay::start(channel, args[1], timed)) {
+          std::cout << "Error: Failed to start UART replay\n";
+          return false;
+        }
+
+        std::cout << "Replaying " << args[1] << "\n";
+        return true;
+      });
+
+#ifdef __linux__
+  cli.registerCommand(
+      "uart-pty",
+      "Expose a UART channel as a pseudo-terminal: uart-pty <ch> [close]",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing channel argument\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          if (args.size() > 1 && args[1] == "close") {
+            auto stats = UARTPtyBridge::getStats(channel);
+            if (!UARTPtyBridge::close(channel)) {
+              std::cout << "Error: Channel is not bridged\n";
+              return false;
+            }
+            std::cout << "Pseudo-terminal closed: " << stats.bytesIn
+                      << " bytes in, " << stats.bytesOut << " bytes out\n";
+            return true;
+          }
+
+          std::string path;
+          if (!UARTPtyBridge::open(channel, path)) {
+            std::cout << "Error: Failed to create pseudo-terminal\n";
+            return false;
+          }
+
+          std::cout << "UART channel " << static_cast<int>(channel)
+                    << " available at " << path << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+#endif
+
   // Register ADC commands
   cli.registerCommand(
       "adc-config",
@@ -183,6 +796,390 @@ int main() {
                         }
                       });
 
+  cli.registerCommand(
+      "adc-signal",
+      "Set the signal of an ADC channel: adc-signal <channel> "
+      "<dc|sine|ramp|square> [offset] [amplitude] [freq-hz] [noise] [seed]",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and shape arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          SignalModel model = ADC::getSignal(channel);
+          if (args[1] == "dc") {
+            model.shape = SignalShape::DC;
+          } else if (args[1] == "sine") {
+            model.shape = SignalShape::SINE;
+          } else if (args[1] == "ramp") {
+            model.shape = SignalShape::RAMP;
+          } else if (args[1] == "square") {
+            model.shape = SignalShape::SQUARE;
+          } else {
+            std::cout << "Error: Unknown signal shape\n";
+            return false;
+          }
+          if (args.size() > 2)
+            model.offset = std::stod(args[2]);
+          if (args.size() > 3)
+            model.amplitude = std::stod(args[3]);
+          if (args.size() > 4)
+            model.frequencyHz = std::stod(args[4]);
+          if (args.size() > 5)
+            model.noise = std::stod(args[5]);
+
+          bool ok = ADC::setSignal(channel, model);
+          if (ok && args.size() > 6)
+            ok = ADC::setSeed(channel, std::stoull(args[6]));
+          if (!ok) {
+            std::cout << "Error: Failed to set ADC signal\n";
+            return false;
+          }
+          std::cout << "ADC signal set\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid signal arguments\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-filter",
+      "Set the filter chain of an ADC channel: adc-filter <channel> off | "
+      "[os=<n>] [cic=<order>] [fir=<taps>[:cutoff]] [iir=<cutoff>] "
+      "[median=<n>]",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and filter arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          FilterConfig config;
+          for (size_t i = 1; i < args.size() && args[1] != "off"; ++i) {
+            size_t eq = args[i].find('=');
+            if (eq == std::string::npos) {
+              std::cout << "Error: Expected key=value, got " << args[i] << "\n";
+              return false;
+            }
+            std::string key = args[i].substr(0, eq);
+            std::string value = args[i].substr(eq + 1);
+            if (key == "os") {
+              config.oversampling = std::stoul(value);
+            } else if (key == "cic") {
+              config.cicOrder = std::stoi(value);
+            } else if (key == "fir") {
+              size_t colon = value.find(':');
+              config.firTaps = std::stoul(value.substr(0, colon));
+              if (colon != std::string::npos)
+                config.firCutoff = std::stod(value.substr(colon + 1));
+            } else if (key == "iir") {
+              config.iirCutoff = std::stod(value);
+            } else if (key == "median") {
+              config.medianWindow = std::stoul(value);
+            } else {
+              std::cout << "Error: Unknown filter stage " << key << "\n";
+              return false;
+            }
+          }
+
+          if (!ADC::setFilter(channel, config)) {
+            std::cout << "Error: Invalid filter configuration\n";
+            return false;
+          }
+          std::cout << "ADC filter set\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid filter arguments\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-trace",
+      "Play a recorded trace on an ADC channel: adc-trace <channel> "
+      "<file> [loop] | off",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and file arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          if (args[1] == "off") {
+            ADC::stopTrace(channel);
+            std::cout << "Trace stopped\n";
+            return true;
+          }
+
+          bool loop = args.size() > 2 && args[2] == "loop";
+          if (!ADC::playTrace(channel, args[1], loop)) {
+            std::cout << "Error: Failed to open trace " << args[1] << "\n";
+            return false;
+          }
+          std::cout << "Playing trace" << (loop ? " in a loop" : "") << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-trace-convert",
+      "Convert a CSV recording to a trace: adc-trace-convert <csv> <trace> "
+      "[sample-rate] [resolution]",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing CSV and trace file arguments\n";
+          return false;
+        }
+
+        try {
+          uint32_t sampleRate = args.size() > 2 ? std::stoul(args[2]) : 0;
+          uint16_t resolution = args.size() > 3 ? std::stoi(args[3]) : 0;
+          if (!convertCsvTrace(args[0], args[1], sampleRate, resolution)) {
+            std::cout << "Error: Failed to convert " << args[0] << "\n";
+            return false;
+          }
+          std::cout << "Trace written to " << args[1] << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid sample rate or resolution\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-window",
+      "Watch an ADC channel with a window comparator: adc-window <channel> "
+      "[<low> <high> [hysteresis] | off]",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing channel argument\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          if (args.size() == 1) {
+            auto status = ADC::getWindowStatus(channel);
+            std::cout << status.crossings << " crossings, last value "
+                      << status.value << ", currently "
+                      << (status.outside ? "outside" : "inside") << "\n";
+            return true;
+          }
+          if (args[1] == "off") {
+            ADC::clearWindow(channel);
+            std::cout << "Window comparator off\n";
+            return true;
+          }
+          if (args.size() < 3) {
+            std::cout << "Error: Missing high threshold\n";
+            return false;
+          }
+
+          uint16_t hysteresis = args.size() > 3 ? std::stoi(args[3]) : 0;
+          if (!ADC::setWindow(channel, std::stoi(args[1]), std::stoi(args[2]),
+                              hysteresis)) {
+            std::cout << "Error: Invalid window\n";
+            return false;
+          }
+          std::cout << "Window comparator set\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel or thresholds\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-block",
+      "Read a block of samples: adc-block <channel> <count>",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and count arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          std::vector<uint16_t> block(std::stoul(args[1]));
+          if (block.empty() ||
+              ADC::readBlock(channel, block.data(), block.size()) == 0) {
+            std::cout << "Error: Failed to read ADC channel\n";
+            return false;
+          }
+
+          auto [min, max] = std::minmax_element(block.begin(), block.end());
+          uint64_t sum = std::accumulate(block.begin(), block.end(),
+                                         static_cast<uint64_t>(0));
+          std::cout << block.size() << " samples, min " << *min << ", max "
+                    << *max << ", mean " << sum / block.size() << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel or count\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-continuous",
+      "Sample an ADC channel continuously: adc-continuous <channel> <on|off>",
+      [](const auto &args) {
+        if (args.size() < 2) {
+          std::cout << "Error: Missing channel and on/off arguments\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          bool ok = args[1] == "on" ? ADC::startContinuous(channel, nullptr)
+                                    : ADC::stopContinuous(channel);
+          if (!ok) {
+            std::cout << "Error: Channel not configured\n";
+            return false;
+          }
+          std::cout << "Continuous sampling " << args[1] << "\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "adc-stats",
+      "Show continuous sampling statistics: adc-stats <channel>",
+      [](const auto &args) {
+        if (args.empty()) {
+          std::cout << "Error: Missing channel argument\n";
+          return false;
+        }
+
+        try {
+          uint8_t channel = std::stoi(args[0]);
+          auto stats = ADC::getStats(channel);
+          std::cout << stats.samples << " samples, " << stats.missedDeadlines
+                    << " missed deadlines, jitter mean "
+                    << stats.meanJitterNs / 1000.0 << " us, max "
+                    << stats.maxJitterNs / 1000.0 << " us, " << stats.blocks
+                    << " blocks, " << stats.overruns << " overruns\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid channel number\n";
+          return false;
+        }
+      });
+
+  // Register interrupt commands
+  cli.registerCommand(
+      "irq-stats",
+      "Show interrupt counters and dispatch latency: irq-stats [reset]",
+      [](const auto &args) {
+        auto &interrupts = InterruptManager::getInstance();
+        if (!args.empty() && args[0] == "reset") {
+          interrupts.resetLatencyStats();
+          interrupts.resetCounters();
+          std::cout << "Interrupt statistics reset\n";
+          return true;
+        }
+
+        auto printCounters = [](const InterruptManager::Counters &c) {
+          std::cout << c.triggered << " triggered, " << c.coalesced
+                    << " coalesced, " << c.dropped << " dropped, "
+                    << c.dispatched << " dispatched\n";
+        };
+        printCounters(interrupts.getCounters());
+        for (size_t t = 0; t < kInterruptTypeCount; ++t) {
+          for (int source = 0; source < 256; ++source) {
+            auto counters = interrupts.getCounters(
+                static_cast<InterruptType>(t), static_cast<uint8_t>(source));
+            if (counters.triggered == 0)
+              continue;
+            std::cout << "  " << kInterruptTypeNames[t] << " " << source
+                      << ": ";
+            printCounters(counters);
+          }
+        }
+
+        auto stats = interrupts.getLatencyStats();
+        std::cout << stats.count << " interrupts dispatched";
+        if (stats.count > 0) {
+          std::cout << ", latency mean " << stats.totalNs / stats.count / 1000.0
+                    << " us, max " << stats.maxNs / 1000.0 << " us";
+        }
+        std::cout << "\n";
+        for (size_t i = 0; i < stats.histogram.size(); ++i) {
+          if (stats.histogram[i] == 0)
+            continue;
+          std::cout << "  >= " << std::setw(10) << (uint64_t{1} << i)
+                    << " ns: " << stats.histogram[i] << "\n";
+        }
+        return true;
+      });
+
+  cli.registerCommand(
+      "irq-limit",
+      "Limit the dispatch rate of an interrupt: irq-limit <type> <source> "
+      "<rate-per-s> [burst] (rate 0 removes the limit)",
+      [](const auto &args) {
+        InterruptType type;
+        uint8_t source;
+        if (!parseInterruptArgs(args, type, source))
+          return false;
+        if (args.size() < 3) {
+          std::cout << "Error: Missing rate argument\n";
+          return false;
+        }
+
+        try {
+          uint32_t rate = std::stoul(args[2]);
+          uint32_t burst = args.size() > 3 ? std::stoul(args[3]) : 1;
+          if (!InterruptManager::getInstance().setRateLimit(type, source, rate,
+                                                             burst)) {
+            std::cout << "Error: Failed to set interrupt rate limit\n";
+            return false;
+          }
+          std::cout << "Interrupt rate limit set\n";
+          return true;
+        } catch (const std::exception &) {
+          std::cout << "Error: Invalid rate arguments\n";
+          return false;
+        }
+      });
+
+  cli.registerCommand(
+      "irq-workers",
+      "Show or set the number of interrupt dispatch workers: irq-workers "
+      "[count]",
+      [](const auto &args) {
+        auto &interrupts = InterruptManager::getInstance();
+        if (!args.empty()) {
+          try {
+            size_t count = std::stoul(args[0]);
+            interrupts.stop();
+            bool ok = interrupts.setWorkerCount(count);
+            interrupts.start();
+            if (!ok) {
+              std::cout << "Error: Worker count must be 1 to "
+                        << InterruptManager::kMaxWorkers << "\n";
+              return false;
+            }
+          } catch (const std::exception &) {
+            std::cout << "Error: Invalid worker count\n";
+            return false;
+          }
+        }
+        std::cout << interrupts.getWorkerCount()
+                  << " interrupt dispatch workers\n";
+        return true;
+      });
+
   // Start the CLI
   cli.run();
 
@@ -1,8 +1,19 @@
 #include "adc.hpp"
+#include "adc_filter.hpp"
+#include "adc_kernels.hpp"
+#include "adc_signal.hpp"
+#include "adc_trace.hpp"
+#include "interrupt.hpp"
+#include "scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
 #include <thread>
-#include <unordered_map>
+#include <vector>
 
 
 using json = nlohmann::json;
@@ -10,126 +21,749 @@ using json = nlohmann::json;
 namespace ti_sdk {
 
 namespace {
-struct ChannelConfig {
-  bool configured;
-  uint32_t sampleRate;
-  uint16_t lastValue;
-  void (*callback)(uint16_t);
-  std::thread samplingThread;
-  bool continuousSampling;
+// A channel that falls further behind than this skips the missed samples
+// instead of producing them back to back
+constexpr uint64_t kMaxCatchUpNs = 1000000;
+
+// Fast channels take several samples per tick instead of waking the
+// scheduler for every sample
+constexpr uint64_t kMinTickNs = 50000;
+
+// Samples generated per pass of a tick
+constexpr size_t kBatchSize = 256;
+
+struct alignas(64) Channel {
+  std::mutex mutex;
+  uint8_t index = 0;
+  bool configured = false;
+  uint32_t sampleRate = 0;
+  uint16_t lastValue = 0;
+  SignalGenerator signal;
+  FilterPipeline filter;
+  std::unique_ptr<TraceSource> trace; // replaces signal while set
+  std::vector<uint16_t> raw; // unfiltered conversions of one filter pass
+
+  // Window comparator
+  bool windowEnabled = false;
+  uint16_t windowLow = 0;
+  uint16_t windowHigh = 0;
+  uint16_t windowHysteresis = 0;
+  ADC::WindowStatus window{};
+
+  // Continuous sampling, guarded by mutex
+  void (*callback)(uint16_t) = nullptr;
+  bool continuous = false;
+  uint32_t timer = 0;
+  double periodNs = 0;
+  uint64_t startNs = 0;
+  uint64_t taken = 0; // samples due since startNs that have been handled
+  uint64_t jitterSumNs = 0;
+  uint64_t jitterCount = 0;
+  ADC::Stats stats{};
+
+  // DMA-style sampling into a caller-owned buffer, guarded by mutex
+  uint16_t *dmaBuffer = nullptr;
+  size_t dmaBlockSize = 0;
+  size_t dmaLength = 0; // blockSize * blockCount
+  size_t dmaPos = 0;
+  bool dmaCircular = false;
+
+  // Ping-pong block delivery, guarded by mutex
+  ADC::BlockCallback blockCallback = nullptr;
+  void *blockContext = nullptr;
+  std::vector<uint16_t> blocks[2];
+  size_t fillIndex = 0;     // buffer being sampled into
+  size_t fillPos = 0;
+  uint64_t fillStartNs = 0; // deadline of the first sample in the buffer
+  bool delivering = false;  // the other buffer is with the consumer
+  uint64_t overruns = 0;    // blocks dropped since the last delivery
+  ADC::SampleBlock ready{}; // block being delivered
+
+  // Absolute deadline of a sample, computed from the start time so that
+  // rounding never accumulates
+  uint64_t deadline(uint64_t index) const {
+    return startNs + static_cast<uint64_t>(index * periodNs);
+  }
 };
 
-std::unordered_map<uint8_t, ChannelConfig> channels;
-std::mutex adc_mutex;
-bool initialized = false;
+const ADCConfig kDefaultConfig{
+    16,      // numChannels
+    12,      // resolution
+    1000000, // maxSampleRate
+    true,    // hasAutoTrigger
+    true     // hasDMA
+};
+
+// Hands full ping-pong buffers to block callbacks on one thread shared by
+// all channels, so that a slow consumer never holds up sampling
+class Delivery {
+public:
+  static Delivery &getInstance() {
+    static Delivery instance;
+    return instance;
+  }
+
+  // Queue the ready block of a channel
+  void post(Channel *channel) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable())
+      thread_ = std::thread(&Delivery::run, this);
+    queue_.push_back(channel);
+    cv_.notify_all();
+  }
+
+  // Drop the queued blocks of a channel and wait for its callback to
+  // return, unless called from that callback
+  void cancel(Channel *channel) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.erase(std::remove(queue_.begin(), queue_.end(), channel),
+                 queue_.end());
+    if (std::this_thread::get_id() != thread_.get_id())
+      cv_.wait(lock, [&] { return current_ != channel; });
+  }
+
+private:
+  Delivery() = default;
+  ~Delivery() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      cv_.notify_all();
+    }
+    if (thread_.joinable())
+      thread_.join();
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+      if (stopping_)
+        return;
+      Channel *channel = queue_.front();
+      queue_.pop_front();
+      current_ = channel;
+      lock.unlock();
+
+      ADC::BlockCallback callback;
+      void *context;
+      ADC::SampleBlock block;
+      {
+        std::lock_guard<std::mutex> channelLock(channel->mutex);
+        callback = channel->blockCallback;
+        context = channel->blockContext;
+        block = channel->ready;
+      }
+      if (callback)
+        callback(block, context);
+      {
+        // Sampling may hand over the next block now
+        std::lock_guard<std::mutex> channelLock(channel->mutex);
+        channel->delivering = false;
+      }
+
+      lock.lock();
+      current_ = nullptr;
+      cv_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Channel *> queue_;
+  Channel *current_ = nullptr; // channel whose callback is running
+  bool stopping_ = false;
+  std::thread thread_;
+};
+
+ADCConfig adc_config = kDefaultConfig;
+const ADCKernels *adc_kernels = selectADCKernels(kDefaultConfig.resolution);
+std::unique_ptr<Channel[]> channels =
+    std::make_unique<Channel[]>(kDefaultConfig.numChannels);
+std::mutex adc_mutex; // serializes initialize and restoreState
+std::atomic<bool> initialized{false};
+
+Channel *findChannel(uint8_t channel) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      channel >= adc_config.numChannels)
+    return nullptr;
+  return &channels[channel];
+}
+
+// Rate of raw conversions, which oversampling raises above the output rate
+uint32_t conversionRate(const Channel &channel) {
+  return channel.sampleRate * channel.filter.getConfig().oversampling;
+}
+
+// Check that a channel converts no faster than the device allows
+bool rateSupported(uint32_t sampleRate, const FilterConfig &filter) {
+  return static_cast<uint64_t>(sampleRate) * filter.oversampling <=
+         adc_config.maxSampleRate;
+}
+
+// Mid-scale input with +/-50 codes of noise at 12 bits, scaled to the
+// resolution
+SignalModel defaultSignal() {
+  SignalModel model;
+  model.offset = adc_kernels->midScale;
+  model.noise = 50.0 * (adc_kernels->maxCode + 1) / 4096;
+  return model;
+}
+
+// Raw conversions from the trace being played, or else the signal model
+void convert(Channel &channel, uint16_t *out, size_t count) {
+  if (channel.trace)
+    channel.trace->read(out, count, *adc_kernels);
+  else
+    channel.signal.generate(out, count, *adc_kernels);
+}
+
+// Index of the first sample that is inside [low, high] if wantInside is
+// set, or outside it otherwise; count if there is none. Whole chunks are
+// tested first with a branch-free reduction, which vectorizes.
+template <bool wantInside>
+size_t findFirst(const uint16_t *data, size_t count, uint16_t low,
+                 uint16_t high) {
+  constexpr size_t kScanChunk = 64;
+  const uint16_t span = high - low;
+  size_t i = 0;
+  for (; i + kScanChunk <= count; i += kScanChunk) {
+    unsigned hit = 0;
+    for (size_t j = 0; j < kScanChunk; ++j) {
+      // Values below low wrap around and compare above span
+      bool outside = static_cast<uint16_t>(data[i + j] - low) > span;
+      hit |= outside != wantInside;
+    }
+    if (hit)
+      break;
+  }
+  for (; i < count; ++i) {
+    bool outside = static_cast<uint16_t>(data[i] - low) > span;
+    if (outside != wantInside)
+      return i;
+  }
+  return count;
+}
+
+// Run the window comparator over new samples, raising ADC_WINDOW whenever
+// the signal leaves the window. It re-arms once the signal is back inside
+// the window narrowed by the hysteresis.
+void compareWindow(Channel &channel, const uint16_t *data, size_t count) {
+  size_t i = 0;
+  while (i < count) {
+    if (!channel.window.outside) {
+      i += findFirst<false>(data + i, count - i, channel.windowLow,
+                            channel.windowHigh);
+      if (i == count)
+        break;
+      channel.window.outside = true;
+      channel.window.value = data[i];
+      ++channel.window.crossings;
+      InterruptManager::getInstance().triggerInterrupt(
+          InterruptType::ADC_WINDOW, channel.index);
+    } else {
+      i += findFirst<true>(data + i, count - i,
+                           channel.windowLow + channel.windowHysteresis,
+                           channel.windowHigh - channel.windowHysteresis);
+      if (i == count)
+        break;
+      channel.window.outside = false;
+    }
+  }
+}
 
-void samplingLoop(uint8_t channel) {
-  auto &config = channels[channel];
-  while (config.continuousSampling) {
-    uint16_t value = ADC::read(channel);
-    if (config.callback) {
-      config.callback(value);
+// Simulate ADC readings of a channel. Requires the channel's mutex.
+void generate(Channel &channel, uint16_t *out, size_t count) {
+  if (!channel.filter.isEnabled()) {
+    convert(channel, out, count);
+  } else {
+    // Bound the scratch buffer for large blocks
+    const size_t oversampling = channel.filter.getConfig().oversampling;
+    for (size_t done = 0; done < count;) {
+      size_t n = std::min(count - done, kBatchSize);
+      channel.raw.resize(n * oversampling);
+      convert(channel, channel.raw.data(), channel.raw.size());
+      channel.filter.process(channel.raw.data(), out + done, n, *adc_kernels);
+      done += n;
     }
-    std::this_thread::sleep_for(
-        std::chrono::microseconds(1000000 / config.sampleRate));
   }
+  if (channel.windowEnabled)
+    compareWindow(channel, out, count);
+  if (count > 0)
+    channel.lastValue = out[count - 1];
+}
+
+// Take every sample that is due, called on the scheduler thread
+uint64_t sampleTick(void *context, uint64_t, uint64_t now) {
+  auto &channel = *static_cast<Channel *>(context);
+  uint16_t batch[kBatchSize];
+  void (*callback)(uint16_t);
+  uint64_t next;
+  bool more;
+  do {
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    if (!channel.continuous)
+      return 0;
+
+    uint64_t first = channel.deadline(channel.taken);
+    if (first > now) // woken early
+      return std::max(first, now + kMinTickNs);
+    uint64_t lateness = now - first;
+    uint64_t elapsed =
+        static_cast<uint64_t>((now - channel.startNs) / channel.periodNs) + 1;
+    uint64_t due = elapsed > channel.taken ? elapsed - channel.taken : 1;
+    if (lateness > kMaxCatchUpNs) {
+      uint64_t skipped = std::min<uint64_t>(
+          due - 1, static_cast<uint64_t>((lateness - kMaxCatchUpNs) /
+                                         channel.periodNs));
+      channel.taken += skipped;
+      channel.stats.missedDeadlines += skipped;
+      due -= skipped;
+      lateness = now - channel.deadline(channel.taken);
+    }
+
+    channel.stats.maxJitterNs = std::max(channel.stats.maxJitterNs, lateness);
+    channel.jitterSumNs += lateness;
+    ++channel.jitterCount;
+    channel.stats.meanJitterNs = channel.jitterSumNs / channel.jitterCount;
+
+    // DMA transfers and block callbacks sample straight into their buffers
+    // and stop at block boundaries; sample callbacks get batches
+    size_t count;
+    uint16_t *out = batch;
+    if (channel.dmaBuffer) {
+      out = channel.dmaBuffer + channel.dmaPos;
+      count = static_cast<size_t>(std::min<uint64_t>(
+          due, channel.dmaBlockSize - channel.dmaPos % channel.dmaBlockSize));
+    } else if (channel.blockCallback) {
+      auto &block = channel.blocks[channel.fillIndex];
+      if (channel.fillPos == 0)
+        channel.fillStartNs = channel.deadline(channel.taken);
+      out = block.data() + channel.fillPos;
+      count = static_cast<size_t>(
+          std::min<uint64_t>(due, block.size() - channel.fillPos));
+    } else {
+      count = static_cast<size_t>(std::min<uint64_t>(due, kBatchSize));
+    }
+    generate(channel, out, count);
+    channel.taken += count;
+    channel.stats.samples += count;
+    more = due > count;
+
+    bool blockDone = false;
+    bool finished = false;
+    if (channel.dmaBuffer) {
+      channel.dmaPos += count;
+      blockDone = channel.dmaPos % channel.dmaBlockSize == 0;
+      if (blockDone)
+        ++channel.stats.blocks;
+      if (channel.dmaPos == channel.dmaLength) {
+        channel.dmaPos = 0;
+        finished = !channel.dmaCircular;
+        if (finished)
+          channel.continuous = false;
+      }
+    }
+    bool post = false;
+    if (channel.blockCallback) {
+      channel.fillPos += count;
+      if (channel.fillPos == channel.blocks[0].size()) {
+        channel.fillPos = 0;
+        ++channel.stats.blocks;
+        if (channel.delivering) {
+          // The consumer still has the other buffer, reuse this one
+          ++channel.overruns;
+          ++channel.stats.overruns;
+        } else {
+          auto &block = channel.blocks[channel.fillIndex];
+          channel.ready = ADC::SampleBlock{block.data(), block.size(),
+                                           channel.fillStartNs,
+                                           channel.overruns};
+          channel.overruns = 0;
+          channel.delivering = true;
+          channel.fillIndex ^= 1;
+          post = true;
+        }
+      }
+    }
+    callback = out == batch ? channel.callback : nullptr;
+    next = std::max(channel.deadline(channel.taken), now + kMinTickNs);
+    lock.unlock();
+
+    if (post)
+      Delivery::getInstance().post(&channel);
+
+    // Sample callbacks run without the channel's mutex so that they may
+    // read the channel, but still on the scheduler thread with the
+    // scheduler locked (see ADC::startContinuous)
+    if (callback) {
+      for (size_t i = 0; i < count; ++i)
+        callback(batch[i]);
+    }
+    if (blockDone) {
+      InterruptManager::getInstance().triggerInterrupt(
+          InterruptType::ADC_COMPLETE, channel.index);
+    }
+    if (finished)
+      return 0;
+  } while (more);
+  return next;
+}
+
+// Stop continuous sampling. Must not hold the channel's mutex, since the
+// scheduler may be waiting for it.
+bool stopSampling(Channel &channel) {
+  uint32_t timer;
+  bool wasRunning;
+  {
+    std::lock_guard<std::mutex> lock(channel.mutex);
+    // A finished DMA transfer is no longer running but still owns a timer
+    wasRunning = channel.continuous;
+    channel.continuous = false;
+    channel.callback = nullptr;
+    channel.dmaBuffer = nullptr;
+    channel.blockCallback = nullptr;
+    timer = channel.timer;
+    channel.timer = 0;
+  }
+  if (timer != 0)
+    TimerScheduler::remove(timer);
+  Delivery::getInstance().cancel(&channel);
+  return wasRunning;
+}
+
+// Start continuous sampling of a configured channel, with setup applied
+// under the channel's mutex before the first tick
+template <typename Setup> bool startSampling(Channel &channel, Setup setup) {
+  stopSampling(channel);
+  uint32_t timer = TimerScheduler::add(sampleTick, &channel);
+  uint64_t startNs = TimerScheduler::nowNs();
+  {
+    std::unique_lock<std::mutex> lock(channel.mutex);
+    if (!channel.configured) {
+      lock.unlock();
+      TimerScheduler::remove(timer);
+      return false;
+    }
+    setup(channel);
+    channel.continuous = true;
+    channel.timer = timer;
+    channel.periodNs = 1e9 / channel.sampleRate;
+    channel.startNs = startNs;
+    channel.taken = 0;
+    channel.jitterSumNs = 0;
+    channel.jitterCount = 0;
+    channel.stats = ADC::Stats{};
+    channel.delivering = false;
+  }
+  TimerScheduler::wake(timer, startNs);
+  return true;
+}
+
+bool resetChannels(const ADCConfig &config) {
+  if (initialized.load()) {
+    for (uint8_t i = 0; i < adc_config.numChannels; ++i)
+      stopSampling(channels[i]);
+  }
+  if (config.numChannels != adc_config.numChannels || !channels)
+    channels = std::make_unique<Channel[]>(config.numChannels);
+  adc_config = config;
+  adc_kernels = selectADCKernels(config.resolution);
+  for (uint8_t i = 0; i < adc_config.numChannels; ++i) {
+    Channel &channel = channels[i];
+    std::lock_guard<std::mutex> lock(channel.mutex);
+    channel.index = i;
+    channel.configured = false;
+    channel.sampleRate = 0;
+    channel.lastValue = 0;
+    channel.callback = nullptr;
+    // Every channel gets its own reproducible noise sequence
+    channel.signal = SignalGenerator(i);
+    channel.signal.setModel(defaultSignal(), 0);
+    channel.filter = FilterPipeline();
+    channel.trace.reset();
+    channel.windowEnabled = false;
+  }
+  return true;
 }
 } // namespace
 
-bool ADC::initialize() {
+bool ADC::initialize() { return initialize(kDefaultConfig); }
+
+bool ADC::initialize(const ADCConfig &config) {
+  if (config.numChannels == 0 || config.maxSampleRate == 0 ||
+      !selectADCKernels(config.resolution))
+    return false;
+
   std::lock_guard<std::mutex> lock(adc_mutex);
+  resetChannels(config);
   initialized = true;
-  channels.clear();
   return true;
 }
 
+const ADCConfig &ADC::getConfig() { return adc_config; }
+
 bool ADC::configureChannel(uint8_t channel, uint32_t sampleRate) {
-  if (!initialized)
+  Channel *state = findChannel(channel);
+  if (!state || sampleRate == 0)
     return false;
 
-  std::lock_guard<std::mutex> lock(adc_mutex);
-  channels[channel] = ChannelConfig{
-      true,          // configured
-      sampleRate,    // sampleRate
-      0,             // lastValue
-      nullptr,       // callback
-      std::thread(), // samplingThread
-      false          // continuousSampling
-  };
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!rateSupported(sampleRate, state->filter.getConfig()))
+      return false;
+  }
+
+  stopSampling(*state);
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->configured = true;
+  state->sampleRate = sampleRate;
+  state->lastValue = 0;
+  state->callback = nullptr;
+  state->signal.setModel(state->signal.getModel(), conversionRate(*state));
+  state->filter.reset();
+  return true;
+}
+
+bool ADC::setSignal(uint8_t channel, const SignalModel &model) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->signal.setModel(model, conversionRate(*state));
+  return true;
+}
+
+SignalModel ADC::getSignal(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return SignalModel{};
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->signal.getModel();
+}
+
+bool ADC::setFilter(uint8_t channel, const FilterConfig &config) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (!rateSupported(state->sampleRate, config) ||
+      !state->filter.configure(config))
+    return false;
+  state->signal.setModel(state->signal.getModel(), conversionRate(*state));
+  return true;
+}
+
+FilterConfig ADC::getFilter(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return FilterConfig{};
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->filter.getConfig();
+}
+
+bool ADC::playTrace(uint8_t channel, const std::string &filename,
+                    bool loop) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  // Map the file before taking the lock, sampling continues meanwhile
+  auto trace = std::make_unique<TraceSource>();
+  if (!trace->open(filename, loop))
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->trace.swap(trace);
+  return true;
+}
+
+bool ADC::stopTrace(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::unique_ptr<TraceSource> trace;
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    trace.swap(state->trace);
+  }
+  return trace != nullptr;
+}
+
+bool ADC::isTracePlaying(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->trace && !state->trace->finished();
+}
+
+bool ADC::setWindow(uint8_t channel, uint16_t low, uint16_t high,
+                    uint16_t hysteresis) {
+  Channel *state = findChannel(channel);
+  if (!state || low > high || high > adc_kernels->maxCode ||
+      2 * hysteresis > high - low)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->windowEnabled = true;
+  state->windowLow = low;
+  state->windowHigh = high;
+  state->windowHysteresis = hysteresis;
+  state->window = WindowStatus{};
+  return true;
+}
+
+bool ADC::clearWindow(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  bool wasEnabled = state->windowEnabled;
+  state->windowEnabled = false;
+  return wasEnabled;
+}
+
+ADC::WindowStatus ADC::getWindowStatus(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return WindowStatus{};
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->window;
+}
+
+bool ADC::setSeed(uint8_t channel, uint64_t seed) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  state->signal.setSeed(seed);
   return true;
 }
 
 uint16_t ADC::read(uint8_t channel) {
-  if (!initialized)
+  Channel *state = findChannel(channel);
+  if (!state)
     return 0;
 
-  std::lock_guard<std::mutex> lock(adc_mutex);
-  auto it = channels.find(channel);
-  if (it == channels.end() || !it->second.configured)
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (!state->configured)
     return 0;
 
-  // Simulate ADC reading with some noise
-  static uint16_t baseValue = 2048; // 12-bit ADC mid-point
-  it->second.lastValue = baseValue + (rand() % 100) - 50;
-  return it->second.lastValue;
+  uint16_t value;
+  generate(*state, &value, 1);
+  return value;
+}
+
+size_t ADC::readBlock(uint8_t channel, uint16_t *dst, size_t count) {
+  Channel *state = findChannel(channel);
+  if (!state || !dst)
+    return 0;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  if (!state->configured)
+    return 0;
+
+  generate(*state, dst, count);
+  return count;
 }
 
 uint16_t ADC::readAverage(uint8_t channel, uint8_t samples) {
   if (!initialized || samples == 0)
     return 0;
 
-  uint32_t sum = 0;
-  for (uint8_t i = 0; i < samples; ++i) {
-    sum += read(channel);
-  }
-  return sum / samples;
+  uint16_t values[UINT8_MAX];
+  if (readBlock(channel, values, samples) != samples)
+    return 0;
+
+  return adc_kernels->sum(values, samples) / samples;
 }
 
 bool ADC::startContinuous(uint8_t channel, void (*callback)(uint16_t)) {
-  if (!initialized)
+  Channel *state = findChannel(channel);
+  if (!state)
     return false;
 
-  std::lock_guard<std::mutex> lock(adc_mutex);
-  auto it = channels.find(channel);
-  if (it == channels.end() || !it->second.configured)
-    return false;
+  return startSampling(*state,
+                       [callback](Channel &c) { c.callback = callback; });
+}
 
-  if (it->second.continuousSampling) {
-    stopContinuous(channel);
-  }
+bool ADC::startDMA(uint8_t channel, uint16_t *buffer, size_t blockSize,
+                   size_t blockCount, bool circular) {
+  Channel *state = findChannel(channel);
+  if (!state || !adc_config.hasDMA || !buffer || blockSize == 0 ||
+      blockCount == 0)
+    return false;
 
-  it->second.callback = callback;
-  it->second.continuousSampling = true;
-  it->second.samplingThread = std::thread(samplingLoop, channel);
-  return true;
+  return startSampling(*state, [=](Channel &c) {
+    c.dmaBuffer = buffer;
+    c.dmaBlockSize = blockSize;
+    c.dmaLength = blockSize * blockCount;
+    c.dmaPos = 0;
+    c.dmaCircular = circular;
+  });
 }
 
-bool ADC::stopContinuous(uint8_t channel) {
-  if (!initialized)
+bool ADC::startBlocks(uint8_t channel, size_t blockSize,
+                      BlockCallback callback, void *context) {
+  Channel *state = findChannel(channel);
+  if (!state || blockSize == 0 || !callback)
     return false;
 
-  std::lock_guard<std::mutex> lock(adc_mutex);
-  auto it = channels.find(channel);
-  if (it == channels.end() || !it->second.configured)
+  return startSampling(*state, [=](Channel &c) {
+    c.blockCallback = callback;
+    c.blockContext = context;
+    c.blocks[0].assign(blockSize, 0);
+    c.blocks[1].assign(blockSize, 0);
+    c.fillIndex = 0;
+    c.fillPos = 0;
+    c.overruns = 0;
+  });
+}
+
+bool ADC::stopContinuous(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
     return false;
 
-  if (it->second.continuousSampling) {
-    it->second.continuousSampling = false;
-    if (it->second.samplingThread.joinable()) {
-      it->second.samplingThread.join();
-    }
+  {
+    std::lock_guard<std::mutex> lock(state->mutex);
+    if (!state->configured)
+      return false;
   }
+  stopSampling(*state);
   return true;
 }
 
+ADC::Stats ADC::getStats(uint8_t channel) {
+  Channel *state = findChannel(channel);
+  if (!state)
+    return Stats{};
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  return state->stats;
+}
+
 std::string ADC::saveState() {
   std::lock_guard<std::mutex> lock(adc_mutex);
 
   json state;
-  state["initialized"] = initialized;
+  state["initialized"] = initialized.load();
+  state["resolution"] = adc_config.resolution;
 
   json channelsState;
-  for (const auto &[channel, config] : channels) {
+  for (uint8_t channel = 0; channel < adc_config.numChannels; ++channel) {
+    Channel &config = channels[channel];
+    std::lock_guard<std::mutex> channelLock(config.mutex);
     if (config.configured) {
       channelsState[std::to_string(channel)] = {
           {"sampleRate", config.sampleRate}, {"lastValue", config.lastValue}};
@@ -143,23 +777,33 @@ std::string ADC::saveState() {
 bool ADC::restoreState(const std::string &state_str) {
   try {
     auto state = json::parse(state_str);
+    bool restoredInitialized = state["initialized"].get<bool>();
+    auto channelsState = state["channels"];
+    for (auto it = channelsState.begin(); it != channelsState.end(); ++it) {
+      if (std::stoul(it.key()) >= adc_config.numChannels ||
+          it.value()["sampleRate"].get<uint32_t>() > adc_config.maxSampleRate)
+        return false;
+    }
 
-    std::lock_guard<std::mutex> lock(adc_mutex);
-    initialized = state["initialized"];
+    // Codes saved at another resolution are rescaled to the current one
+    int shift = adc_config.resolution -
+                state.value("resolution", static_cast<int>(12));
 
-    channels.clear();
-    auto channelsState = state["channels"];
+    std::lock_guard<std::mutex> lock(adc_mutex);
+    resetChannels(adc_config);
     for (auto it = channelsState.begin(); it != channelsState.end(); ++it) {
-      uint8_t channel = std::stoi(it.key());
-      channels[channel] = ChannelConfig{
-          true,                     // configured
-          it.value()["sampleRate"], // sampleRate
-          it.value()["lastValue"],  // lastValue
-          nullptr,                  // callback
-          std::thread(),            // samplingThread
-          false                     // continuousSampling
-      };
+      Channel &channel = channels[std::stoi(it.key())];
+      std::lock_guard<std::mutex> channelLock(channel.mutex);
+      channel.configured = true;
+      channel.sampleRate = it.value()["sampleRate"];
+      uint32_t lastValue = it.value()["lastValue"].get<uint16_t>();
+      lastValue = shift >= 0 ? lastValue << shift : lastValue >> -shift;
+      channel.lastValue = static_cast<uint16_t>(
+          std::min<uint32_t>(lastValue, adc_kernels->maxCode));
+      channel.signal.setModel(channel.signal.getModel(),
+                              conversionRate(channel));
     }
+    initialized = restoredInitialized;
 
     return true;
   } catch (const std::exception &) {
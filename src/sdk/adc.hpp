@@ -1,31 +1,143 @@
 #pragma once
 
+#include "adc_filter.hpp"
+#include "adc_signal.hpp"
+#include "device_profile.hpp"
+#include <cstddef>
 #include <cstdint>
 #include <string>
 #include <vector>
 
 namespace ti_sdk {
 
+// Emulated ADC. Every channel has its own lock, and continuous sampling of
+// all channels runs on the shared TimerScheduler thread with absolute
+// sample deadlines.
 class ADC {
 public:
+  struct Stats {
+    uint64_t samples;         // samples taken in continuous mode
+    uint64_t missedDeadlines; // samples skipped after falling behind
+    uint64_t maxJitterNs;     // worst delay between deadline and sample
+    uint64_t meanJitterNs;    // average delay between deadline and sample
+    uint64_t blocks;          // DMA or callback blocks completed
+    uint64_t overruns;        // blocks dropped while the consumer was busy
+  };
+
+  // A full buffer of consecutive samples, valid during the callback only
+  struct SampleBlock {
+    const uint16_t *data;
+    size_t size;
+    uint64_t timestampNs; // TimerScheduler::nowNs() deadline of data[0]
+    uint64_t overruns;    // blocks dropped since the previous delivery
+  };
+
+  struct WindowStatus {
+    bool outside;       // the signal has left the window and not returned
+    uint64_t crossings; // times the signal left the window
+    uint16_t value;     // sample that last left the window
+  };
+
+  using BlockCallback = void (*)(const SampleBlock &block, void *context);
+
   // Initialize ADC subsystem
   static bool initialize();
 
-  // Configure ADC channel
+  // Initialize with the channel count and limits of a device profile.
+  // Supports 8, 10, 12, 14 and 16-bit resolutions; samples are codes of
+  // the configured resolution throughout.
+  static bool initialize(const ADCConfig &config);
+
+  // Get the active configuration
+  static const ADCConfig &getConfig();
+
+  // Configure ADC channel. Fails if sampleRate times the channel's
+  // oversampling exceeds the maximum sample rate.
   static bool configureChannel(uint8_t channel, uint32_t sampleRate);
 
+  // Set the analog signal seen by a channel. Restarts the signal.
+  static bool setSignal(uint8_t channel, const SignalModel &model);
+
+  // Get the signal of a channel, by default mid-scale with some noise
+  static SignalModel getSignal(uint8_t channel);
+
+  // Set the oversampling and filter chain of a channel. The signal is
+  // converted at sampleRate * oversampling and filtered down to sampleRate.
+  // Returns false for out-of-range configurations.
+  static bool setFilter(uint8_t channel, const FilterConfig &config);
+
+  // Get the filter chain of a channel
+  static FilterConfig getFilter(uint8_t channel);
+
+  // Replace the signal of a channel with the samples of a trace file, see
+  // adc_trace.hpp. Samples are served one per conversion. Looping traces
+  // restart at the end, others hold their last sample.
+  static bool playTrace(uint8_t channel, const std::string &filename,
+                        bool loop = false);
+
+  // Return a channel to its signal model
+  static bool stopTrace(uint8_t channel);
+
+  // Check if a channel still has trace samples to play
+  static bool isTracePlaying(uint8_t channel);
+
+  // Watch a channel with a window comparator. Every sample that leaves
+  // [low, high] while the comparator is armed raises ADC_WINDOW with the
+  // channel as source; the comparator re-arms once a sample is back within
+  // [low + hysteresis, high - hysteresis].
+  static bool setWindow(uint8_t channel, uint16_t low, uint16_t high,
+                        uint16_t hysteresis = 0);
+
+  // Stop watching a channel
+  static bool clearWindow(uint8_t channel);
+
+  // Get the comparator state of a channel
+  static WindowStatus getWindowStatus(uint8_t channel);
+
+  // Seed the noise of a channel, which defaults to the channel number.
+  // Restarts the signal.
+  static bool setSeed(uint8_t channel, uint64_t seed);
+
   // Read ADC value
   static uint16_t read(uint8_t channel);
 
+  // Read count consecutive samples into dst under a single lock. Returns
+  // the number of samples read, 0 if the channel is not configured.
+  static size_t readBlock(uint8_t channel, uint16_t *dst, size_t count);
+
   // Read ADC value with averaging
   static uint16_t readAverage(uint8_t channel, uint8_t samples);
 
-  // Start continuous sampling
+  // Start continuous sampling. The callback gets every sample on the
+  // TimerScheduler thread with the scheduler locked: it must return
+  // quickly, must not block, and must not start or stop sampling or
+  // anything else driven by TimerScheduler (UART timing, waveforms).
+  // Use startBlocks for heavier consumers.
   static bool startContinuous(uint8_t channel, void (*callback)(uint16_t));
 
-  // Stop continuous sampling
+  // Start continuous sampling into a pair of blockSize buffers. Every full
+  // buffer is passed to callback on a delivery thread while sampling
+  // continues into the other one. Blocks that fill up while the callback
+  // is still busy are dropped and counted as overruns. After
+  // stopContinuous returns, the callback is no longer running.
+  static bool startBlocks(uint8_t channel, size_t blockSize,
+                          BlockCallback callback, void *context);
+
+  // Start DMA-style sampling into a caller-owned buffer of blockCount
+  // blocks of blockSize samples, paced like continuous sampling. Raises
+  // ADC_COMPLETE with the channel as source after every block; block
+  // (Stats::blocks - 1) % blockCount is the one just filled. Circular
+  // transfers wrap to the first block, others stop after the last one.
+  // The buffer must stay valid until stopContinuous returns.
+  static bool startDMA(uint8_t channel, uint16_t *buffer, size_t blockSize,
+                       size_t blockCount, bool circular = true);
+
+  // Stop continuous or DMA sampling
   static bool stopContinuous(uint8_t channel);
 
+  // Get continuous sampling statistics of a channel
+  static Stats getStats(uint8_t channel);
+
   // Save current ADC state to JSON
   static std::string saveState();
 
@@ -0,0 +1,177 @@
+#include "adc_filter.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace ti_sdk {
+
+namespace {
+constexpr size_t kChunkSize = 256;
+constexpr double kPi = 3.141592653589793;
+} // namespace
+
+bool FilterPipeline::configure(const FilterConfig &config) {
+  if (config.oversampling == 0 || config.oversampling > 1024 ||
+      config.cicOrder == 0 || config.cicOrder > 5 || config.firTaps > 255 ||
+      config.medianWindow > 63)
+    return false;
+  if (config.firTaps > 0 &&
+      !(config.firCutoff > 0 && config.firCutoff < 0.5))
+    return false;
+  // The decimator registers must hold a full-scale 16-bit output times the
+  // gain, which limits oversampling^order to 2^47
+  if (std::pow(static_cast<double>(config.oversampling), config.cicOrder) >
+      std::ldexp(1.0, 47))
+    return false;
+  if (config.iirCutoff != 0 &&
+      !(config.iirCutoff > 0 && config.iirCutoff < 0.5))
+    return false;
+
+  config_ = config;
+  enabled_ = config.oversampling > 1 || config.firTaps > 0 ||
+             config.iirCutoff > 0 || config.medianWindow > 1;
+  cicGain_ = std::pow(static_cast<double>(config.oversampling),
+                      config.cicOrder);
+
+  // Blackman-windowed sinc, normalized to unity gain at DC
+  taps_.assign(config.firTaps, 0);
+  double center = (static_cast<double>(config.firTaps) - 1) / 2;
+  double sum = 0;
+  for (size_t k = 0; k < taps_.size(); ++k) {
+    double x = k - center;
+    double sinc = x == 0 ? 2 * config.firCutoff
+                         : std::sin(2 * kPi * config.firCutoff * x) / (kPi * x);
+    double phase = taps_.size() > 1 ? 2 * kPi * k / (taps_.size() - 1) : 0;
+    double window = 0.42 - 0.5 * std::cos(phase) + 0.08 * std::cos(2 * phase);
+    taps_[k] = sinc * window;
+    sum += taps_[k];
+  }
+  for (double &tap : taps_)
+    tap /= sum;
+
+  // Bilinear-transformed Butterworth low-pass
+  if (config.iirCutoff > 0) {
+    const double q = 1 / std::sqrt(2.0);
+    double k = std::tan(kPi * config.iirCutoff);
+    double norm = 1 / (1 + k / q + k * k);
+    b0_ = k * k * norm;
+    b1_ = 2 * b0_;
+    b2_ = b0_;
+    a1_ = 2 * (k * k - 1) * norm;
+    a2_ = (1 - k / q + k * k) * norm;
+  }
+
+  reset();
+  return true;
+}
+
+void FilterPipeline::reset() {
+  std::fill(std::begin(integrators_), std::end(integrators_), 0);
+  std::fill(std::begin(combs_), std::end(combs_), 0);
+  firBuffer_.clear();
+  z1_ = z2_ = 0;
+  window_.clear();
+  sorted_.clear();
+  windowPos_ = 0;
+}
+
+void FilterPipeline::decimate(const uint16_t *in, double *out, size_t count) {
+  const uint32_t rate = config_.oversampling;
+  if (config_.cicOrder == 1) {
+    // A first order CIC is a plain block average
+    for (size_t i = 0; i < count; ++i) {
+      uint32_t sum = 0;
+      for (uint32_t j = 0; j < rate; ++j)
+        sum += in[i * rate + j];
+      out[i] = static_cast<double>(sum) / rate;
+    }
+    return;
+  }
+
+  // Integrators run at the input rate and combs at the output rate. The
+  // integer arithmetic wraps, which the combs undo exactly.
+  const uint8_t order = config_.cicOrder;
+  for (size_t i = 0; i < count; ++i) {
+    for (uint32_t j = 0; j < rate; ++j) {
+      uint64_t acc = in[i * rate + j];
+      for (uint8_t s = 0; s < order; ++s) {
+        acc += static_cast<uint64_t>(integrators_[s]);
+        integrators_[s] = static_cast<int64_t>(acc);
+      }
+    }
+    int64_t value = integrators_[order - 1];
+    for (uint8_t s = 0; s < order; ++s) {
+      int64_t delayed = combs_[s];
+      combs_[s] = value;
+      value = static_cast<int64_t>(static_cast<uint64_t>(value) -
+                                   static_cast<uint64_t>(delayed));
+    }
+    out[i] = value / cicGain_;
+  }
+}
+
+void FilterPipeline::fir(double *data, size_t count) {
+  const size_t taps = taps_.size();
+  if (firBuffer_.empty())
+    firBuffer_.assign(taps - 1, data[0]); // start settled on the first sample
+  firBuffer_.insert(firBuffer_.end(), data, data + count);
+
+  // Accumulate one tap over the whole block at a time, which vectorizes
+  // without reordering any sums
+  const double *x = firBuffer_.data();
+  std::fill(data, data + count, 0.0);
+  for (size_t k = 0; k < taps; ++k) {
+    const double tap = taps_[k];
+    for (size_t i = 0; i < count; ++i)
+      data[i] += tap * x[i + k];
+  }
+  firBuffer_.erase(firBuffer_.begin(), firBuffer_.end() - (taps - 1));
+}
+
+void FilterPipeline::iir(double *data, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    double x = data[i];
+    double y = b0_ * x + z1_;
+    z1_ = b1_ * x - a1_ * y + z2_;
+    z2_ = b2_ * x - a2_ * y;
+    data[i] = y;
+  }
+}
+
+void FilterPipeline::median(double *data, size_t count) {
+  const size_t size = config_.medianWindow;
+  if (window_.empty()) {
+    window_.assign(size, data[0]);
+    sorted_.assign(size, data[0]);
+  }
+  for (size_t i = 0; i < count; ++i) {
+    double oldest = window_[windowPos_];
+    window_[windowPos_] = data[i];
+    windowPos_ = (windowPos_ + 1) % size;
+    sorted_.erase(std::lower_bound(sorted_.begin(), sorted_.end(), oldest));
+    sorted_.insert(std::upper_bound(sorted_.begin(), sorted_.end(), data[i]),
+                   data[i]);
+    data[i] = sorted_[size / 2];
+  }
+}
+
+void FilterPipeline::process(const uint16_t *in, uint16_t *out, size_t count,
+                             const ADCKernels &kernels) {
+  double chunk[kChunkSize];
+  while (count > 0) {
+    size_t n = std::min(count, kChunkSize);
+    decimate(in, chunk, n);
+    if (!taps_.empty())
+      fir(chunk, n);
+    if (config_.iirCutoff > 0)
+      iir(chunk, n);
+    if (config_.medianWindow > 1)
+      median(chunk, n);
+    kernels.quantize(chunk, out, n);
+    in += n * config_.oversampling;
+    out += n;
+    count -= n;
+  }
+}
+
+} // namespace ti_sdk
\ No newline at end of file
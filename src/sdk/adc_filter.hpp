@@ -0,0 +1,72 @@
+#pragma once
+
+#include "adc_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ti_sdk {
+
+// Per-channel conversion chain, applied in the order of the fields. Cutoffs
+// are fractions of the output sample rate and must be below 0.5.
+struct FilterConfig {
+  uint32_t oversampling = 1; // raw conversions per output sample, <= 1024
+  uint8_t cicOrder = 1;      // decimator order 1-5, 1 is a plain average
+  size_t firTaps = 0;        // windowed-sinc low-pass taps, 0 disables
+  double firCutoff = 0.25;
+  double iirCutoff = 0;      // Butterworth biquad low-pass, 0 disables
+  size_t medianWindow = 0;   // moving median of up to 63 samples, 0 disables
+};
+
+// Oversampling and decimation filter chain of an ADC channel. Works on
+// whole blocks: the decimator sums with integer integrators and combs, and
+// the FIR runs over a contiguous history + block buffer so its inner
+// product vectorizes.
+class FilterPipeline {
+public:
+  // Apply a configuration and clear the filter state. Returns false and
+  // leaves the pipeline unchanged if the configuration is out of range.
+  bool configure(const FilterConfig &config);
+
+  // Clear the filter state
+  void reset();
+
+  // True if any stage does more than pass samples through
+  bool isEnabled() const { return enabled_; }
+
+  const FilterConfig &getConfig() const { return config_; }
+
+  // Filter count * oversampling raw samples into count output samples,
+  // quantized by the converter kernels
+  void process(const uint16_t *in, uint16_t *out, size_t count,
+               const ADCKernels &kernels);
+
+private:
+  void decimate(const uint16_t *in, double *out, size_t count);
+  void fir(double *data, size_t count);
+  void iir(double *data, size_t count);
+  void median(double *data, size_t count);
+
+  FilterConfig config_;
+  bool enabled_ = false;
+
+  // CIC decimator
+  int64_t integrators_[5] = {};
+  int64_t combs_[5] = {};
+  double cicGain_ = 1;
+
+  // FIR low-pass
+  std::vector<double> taps_;
+  std::vector<double> firBuffer_; // history followed by the current block
+
+  // Biquad low-pass, transposed direct form II
+  double b0_ = 0, b1_ = 0, b2_ = 0, a1_ = 0, a2_ = 0;
+  double z1_ = 0, z2_ = 0;
+
+  // Moving median
+  std::vector<double> window_; // ring of the last samples
+  std::vector<double> sorted_; // the same samples in order
+  size_t windowPos_ = 0;
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,54 @@
+#include "adc_kernels.hpp"
+#include <algorithm>
+
+
+namespace ti_sdk {
+
+namespace {
+template <unsigned kBits> struct Kernels {
+  static constexpr uint16_t kMaxCode = (1u << kBits) - 1;
+
+  static void quantize(const double *in, uint16_t *out, size_t count) {
+    for (size_t i = 0; i < count; ++i) {
+      double value = std::min<double>(std::max(in[i] + 0.5, 0.0), kMaxCode);
+      out[i] = static_cast<uint16_t>(value);
+    }
+  }
+
+  static void clamp(uint16_t *data, size_t count) {
+    if (kMaxCode == UINT16_MAX)
+      return;
+    for (size_t i = 0; i < count; ++i)
+      data[i] = std::min(data[i], kMaxCode);
+  }
+
+  static uint32_t sum(const uint16_t *data, size_t count) {
+    uint32_t total = 0;
+    for (size_t i = 0; i < count; ++i)
+      total += data[i];
+    return total;
+  }
+
+  static constexpr ADCKernels table{kBits, kMaxCode, 1u << (kBits - 1),
+                                    quantize, clamp, sum};
+};
+} // namespace
+
+const ADCKernels *selectADCKernels(uint8_t resolution) {
+  switch (resolution) {
+  case 8:
+    return &Kernels<8>::table;
+  case 10:
+    return &Kernels<10>::table;
+  case 12:
+    return &Kernels<12>::table;
+  case 14:
+    return &Kernels<14>::table;
+  case 16:
+    return &Kernels<16>::table;
+  default:
+    return nullptr;
+  }
+}
+
+} // namespace ti_sdk
\ No newline at end of file
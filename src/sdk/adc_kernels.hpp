@@ -0,0 +1,30 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+
+namespace ti_sdk {
+
+// Per-sample loops of the ADC, compiled once for every supported
+// resolution so that the full-scale code is a constant. A table is picked
+// when the ADC is configured, leaving no resolution checks per sample.
+struct ADCKernels {
+  uint8_t resolution;
+  uint16_t maxCode;  // full-scale code, 2^resolution - 1
+  uint16_t midScale; // 2^(resolution - 1)
+
+  // Round analog values to codes, clamped to [0, maxCode]
+  void (*quantize)(const double *in, uint16_t *out, size_t count);
+
+  // Clamp codes to [0, maxCode] in place
+  void (*clamp)(uint16_t *data, size_t count);
+
+  // Sum of count codes, exact for up to 65537 full-scale samples
+  uint32_t (*sum)(const uint16_t *data, size_t count);
+};
+
+// Get the kernels of an 8, 10, 12, 14 or 16-bit converter, nullptr for
+// other resolutions
+const ADCKernels *selectADCKernels(uint8_t resolution);
+
+} // namespace ti_sdk
\ No newline at end of file
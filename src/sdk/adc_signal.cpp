@@ -0,0 +1,151 @@
+#include "adc_signal.hpp"
+#include <algorithm>
+#include <cmath>
+
+
+namespace ti_sdk {
+
+namespace {
+constexpr size_t kChunkSize = 64;
+constexpr double kTwoPi = 6.283185307179586;
+
+uint64_t splitMix64(uint64_t &state) {
+  uint64_t z = (state += 0x9E3779B97F4A7C15ull);
+  z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ull;
+  z = (z ^ (z >> 27)) * 0x94D049BB133111EBull;
+  return z ^ (z >> 31);
+}
+} // namespace
+
+void SignalGenerator::Phasor::init(double amp, double frequencyHz,
+                                   double phase, uint32_t sampleRate) {
+  double w = sampleRate ? kTwoPi * frequencyHz / sampleRate : 0;
+  re = std::cos(phase);
+  im = std::sin(phase);
+  cosW = std::cos(w);
+  sinW = std::sin(w);
+  amplitude = amp;
+}
+
+void SignalGenerator::Phasor::add(double *out, size_t count) {
+  for (size_t i = 0; i < count; ++i) {
+    out[i] += amplitude * im;
+    double nextRe = re * cosW - im * sinW;
+    im = re * sinW + im * cosW;
+    re = nextRe;
+  }
+  // Pull the phasor back onto the unit circle so rounding never grows
+  double scale = 1.0 / std::sqrt(re * re + im * im);
+  re *= scale;
+  im *= scale;
+}
+
+SignalGenerator::SignalGenerator(uint64_t seed) : seed_(seed) { restart(); }
+
+void SignalGenerator::setModel(const SignalModel &model, uint32_t sampleRate) {
+  model_ = model;
+  sampleRate_ = sampleRate;
+  restart();
+}
+
+void SignalGenerator::setSeed(uint64_t seed) {
+  seed_ = seed;
+  restart();
+}
+
+void SignalGenerator::restart() {
+  uint64_t state = seed_;
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    uint64_t a = splitMix64(state);
+    uint64_t b = splitMix64(state);
+    lanes_[0][lane] = static_cast<uint32_t>(a);
+    lanes_[1][lane] = static_cast<uint32_t>(a >> 32);
+    lanes_[2][lane] = static_cast<uint32_t>(b);
+    lanes_[3][lane] = static_cast<uint32_t>(b >> 32) | 1; // never all zero
+  }
+  spareNext_ = kLanes;
+
+  phase_ = 0;
+  step_ = sampleRate_ ? model_.frequencyHz / sampleRate_ : 0;
+  phasors_.clear();
+  if (model_.shape == SignalShape::SINE) {
+    phasors_.emplace_back();
+    phasors_.back().init(model_.amplitude, model_.frequencyHz, 0,
+                         sampleRate_);
+  }
+  for (const auto &tone : model_.tones) {
+    phasors_.emplace_back();
+    phasors_.back().init(tone.amplitude, tone.frequencyHz, tone.phase,
+                         sampleRate_);
+  }
+}
+
+void SignalGenerator::fillWave(double *out, size_t count) {
+  std::fill(out, out + count, model_.offset);
+  if (model_.shape == SignalShape::RAMP ||
+      model_.shape == SignalShape::SQUARE) {
+    bool ramp = model_.shape == SignalShape::RAMP;
+    for (size_t i = 0; i < count; ++i) {
+      if (ramp)
+        out[i] += model_.amplitude * (2 * phase_ - 1);
+      else
+        out[i] += phase_ < 0.5 ? model_.amplitude : -model_.amplitude;
+      phase_ += step_;
+      phase_ -= std::floor(phase_);
+    }
+  }
+  for (auto &phasor : phasors_)
+    phasor.add(out, count);
+}
+
+void SignalGenerator::nextNoise(uint32_t *result) {
+  for (size_t lane = 0; lane < kLanes; ++lane) {
+    result[lane] = lanes_[0][lane] + lanes_[3][lane];
+    uint32_t t = lanes_[1][lane] << 9;
+    lanes_[2][lane] ^= lanes_[0][lane];
+    lanes_[3][lane] ^= lanes_[1][lane];
+    lanes_[1][lane] ^= lanes_[2][lane];
+    lanes_[0][lane] ^= lanes_[3][lane];
+    lanes_[2][lane] ^= t;
+    lanes_[3][lane] = (lanes_[3][lane] << 11) | (lanes_[3][lane] >> 21);
+  }
+}
+
+void SignalGenerator::addNoise(double *out, size_t count) {
+  if (model_.noise == 0)
+    return;
+
+  // Signed 32-bit values scaled to [-noise, noise). Outputs left over from
+  // a partial group are used first, so the noise sequence does not depend
+  // on how the samples are split into calls.
+  const double scale = model_.noise / 2147483648.0;
+  size_t i = 0;
+  for (; i < count && spareNext_ < kLanes; ++i)
+    out[i] += static_cast<int32_t>(spare_[spareNext_++]) * scale;
+  for (; i + kLanes <= count; i += kLanes) {
+    uint32_t result[kLanes];
+    nextNoise(result);
+    for (size_t lane = 0; lane < kLanes; ++lane)
+      out[i + lane] += static_cast<int32_t>(result[lane]) * scale;
+  }
+  if (i < count) {
+    nextNoise(spare_);
+    for (spareNext_ = 0; i < count; ++i)
+      out[i] += static_cast<int32_t>(spare_[spareNext_++]) * scale;
+  }
+}
+
+void SignalGenerator::generate(uint16_t *out, size_t count,
+                               const ADCKernels &kernels) {
+  double chunk[kChunkSize];
+  while (count > 0) {
+    size_t n = std::min(count, kChunkSize);
+    fillWave(chunk, n);
+    addNoise(chunk, n);
+    kernels.quantize(chunk, out, n);
+    out += n;
+    count -= n;
+  }
+}
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,86 @@
+#pragma once
+
+#include "adc_kernels.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+namespace ti_sdk {
+
+enum class SignalShape {
+  DC,     // constant offset
+  SINE,   // offset + amplitude * sin
+  RAMP,   // sawtooth from offset - amplitude to offset + amplitude
+  SQUARE, // offset +/- amplitude with 50% duty cycle
+};
+
+// An extra sine summed on top of the base shape
+struct SignalTone {
+  double amplitude;   // codes
+  double frequencyHz;
+  double phase;       // radians
+};
+
+// Analog input of a channel, in ADC codes
+struct SignalModel {
+  SignalShape shape = SignalShape::DC;
+  double offset = 2048; // mid-scale of a 12-bit converter
+  double amplitude = 0;
+  double frequencyHz = 0;
+  double noise = 50; // uniform noise in [-noise, noise)
+  std::vector<SignalTone> tones;
+};
+
+// Generates the samples of a signal model. Noise comes from four
+// interleaved xoshiro128+ lanes and sines from rotating phasors, computed
+// a chunk at a time so that the inner loops vectorize. The output is fully
+// determined by the model, sample rate and seed.
+class SignalGenerator {
+public:
+  explicit SignalGenerator(uint64_t seed = 0);
+
+  // Set the model and sample rate and restart the signal
+  void setModel(const SignalModel &model, uint32_t sampleRate);
+
+  // Set the noise seed and restart the signal
+  void setSeed(uint64_t seed);
+
+  // Restart from phase zero and the initial noise state
+  void restart();
+
+  // Generate count samples quantized by the converter kernels
+  void generate(uint16_t *out, size_t count, const ADCKernels &kernels);
+
+  const SignalModel &getModel() const { return model_; }
+  uint64_t getSeed() const { return seed_; }
+
+private:
+  static constexpr size_t kLanes = 4;
+
+  // Sine by complex rotation, one multiply per sample instead of sin()
+  struct Phasor {
+    double re, im;     // current position on the unit circle
+    double cosW, sinW; // rotation per sample
+    double amplitude;
+
+    void init(double amplitude, double frequencyHz, double phase,
+              uint32_t sampleRate);
+    void add(double *out, size_t count);
+  };
+
+  void fillWave(double *out, size_t count);
+  void nextNoise(uint32_t *result); // one output per lane
+  void addNoise(double *out, size_t count);
+
+  SignalModel model_;
+  uint32_t sampleRate_ = 0;
+  uint64_t seed_;
+  uint32_t lanes_[4][kLanes]; // xoshiro128+ state, [word][lane]
+  uint32_t spare_[kLanes];    // last group of outputs, used from spareNext_
+  size_t spareNext_ = kLanes;
+  double phase_ = 0;          // RAMP and SQUARE cycle position in [0, 1)
+  double step_ = 0;
+  std::vector<Phasor> phasors_; // base sine first, then the tones
+};
+
+} // namespace ti_sdk
\ No newline at end of file
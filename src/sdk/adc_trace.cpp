@@ -0,0 +1,101 @@
+#include "adc_trace.hpp"
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <fstream>
+
+
+namespace ti_sdk {
+
+bool convertCsvTrace(const std::string &csvFilename,
+                     const std::string &traceFilename, uint32_t sampleRate,
+                     uint16_t resolution) {
+  std::ifstream csv(csvFilename);
+  if (!csv)
+    return false;
+  std::ofstream trace(traceFilename, std::ios::binary | std::ios::trunc);
+  if (!trace)
+    return false;
+
+  ADCTraceHeader header{};
+  std::memcpy(header.magic, kAdcTraceMagic, sizeof(header.magic));
+  header.sampleRate = sampleRate;
+  header.resolution = resolution;
+  trace.write(reinterpret_cast<const char *>(&header), sizeof(header));
+
+  std::string line;
+  while (std::getline(csv, line)) {
+    size_t comma = line.find_last_of(",;\t");
+    const char *field = line.c_str();
+    if (comma != std::string::npos)
+      field += comma + 1;
+    char *end;
+    double value = std::strtod(field, &end);
+    if (end == field)
+      continue;
+
+    uint16_t sample = static_cast<uint16_t>(
+        std::min(std::max(value + 0.5, 0.0), 65535.0));
+    uint8_t bytes[2] = {static_cast<uint8_t>(sample),
+                        static_cast<uint8_t>(sample >> 8)};
+    trace.write(reinterpret_cast<const char *>(bytes), sizeof(bytes));
+  }
+  return static_cast<bool>(trace);
+}
+
+bool TraceSource::open(const std::string &filename, bool loop) {
+  if (!file_.open(filename))
+    return false;
+
+  size_t available;
+  const uint8_t *head = file_.view(0, sizeof(header_), available);
+  header_ = ADCTraceHeader{};
+  dataOffset_ = 0;
+  if (head && available >= sizeof(header_) &&
+      std::memcmp(head, kAdcTraceMagic, sizeof(kAdcTraceMagic)) == 0) {
+    std::memcpy(&header_, head, sizeof(header_));
+    dataOffset_ = sizeof(header_);
+  }
+
+  length_ = (file_.size() - dataOffset_) / sizeof(uint16_t);
+  position_ = 0;
+  last_ = 0;
+  loop_ = loop;
+  finished_ = length_ == 0;
+  if (finished_)
+    file_.close();
+  return length_ > 0;
+}
+
+void TraceSource::read(uint16_t *out, size_t count,
+                       const ADCKernels &kernels) {
+  while (count > 0 && !finished_) {
+    size_t wanted =
+        static_cast<size_t>(std::min<uint64_t>(count, length_ - position_));
+    size_t available;
+    const uint8_t *data =
+        file_.view(dataOffset_ + position_ * sizeof(uint16_t),
+                   wanted * sizeof(uint16_t), available);
+    if (!data) {
+      finished_ = true;
+      break;
+    }
+
+    size_t n = std::min(wanted, available / sizeof(uint16_t));
+    std::memcpy(out, data, n * sizeof(uint16_t));
+    kernels.clamp(out, n);
+    last_ = out[n - 1];
+    out += n;
+    count -= n;
+    position_ += n;
+    if (position_ == length_) {
+      position_ = 0;
+      finished_ = !loop_;
+      if (finished_)
+        file_.close();
+    }
+  }
+  std::fill(out, out + count, last_);
+}
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,63 @@
+#pragma once
+
+#include "adc_kernels.hpp"
+#include "mapped_file.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ti_sdk {
+
+// Trace files may start with this header, followed by little-endian 16-bit
+// samples. Files without the magic are read as bare samples.
+constexpr char kAdcTraceMagic[8] = {'A', 'D', 'C', 'T', 'R', 'A', 'C', 'E'};
+
+struct ADCTraceHeader {
+  char magic[8];
+  uint32_t sampleRate; // rate of the recording, 0 if unknown
+  uint16_t resolution; // bits per sample, 0 if unknown
+  uint16_t reserved;
+};
+
+static_assert(sizeof(ADCTraceHeader) == 16, "ADCTraceHeader must be packed");
+
+// Convert a CSV recording with one sample per line, taken from the last
+// column, into a trace file. Lines that do not end in a number, such as
+// column headers, are skipped. Streams both files.
+bool convertCsvTrace(const std::string &csvFilename,
+                     const std::string &traceFilename,
+                     uint32_t sampleRate = 0, uint16_t resolution = 0);
+
+// Serves the samples of a trace file. The file is read through a small
+// sliding memory-mapped window, so memory use does not depend on its size,
+// and samples are copied out of the mapping without any parsing.
+class TraceSource {
+public:
+  TraceSource() : file_(kWindowSize) {}
+
+  // Open a trace. Looping traces restart at the first sample after the
+  // last one; others hold the last sample once finished.
+  bool open(const std::string &filename, bool loop);
+
+  // Copy the next count samples, clamped by the converter kernels
+  void read(uint16_t *out, size_t count, const ADCKernels &kernels);
+
+  bool finished() const { return finished_; }
+  uint64_t length() const { return length_; }
+  uint64_t position() const { return position_; }
+  const ADCTraceHeader &getHeader() const { return header_; }
+
+private:
+  static constexpr size_t kWindowSize = 1024 * 1024;
+
+  MappedFile file_;
+  ADCTraceHeader header_{};
+  uint64_t dataOffset_ = 0;
+  uint64_t length_ = 0;   // samples in the file
+  uint64_t position_ = 0; // next sample
+  uint16_t last_ = 0;
+  bool loop_ = false;
+  bool finished_ = false;
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,136 @@
+#include "frame_decoder.hpp"
+#include <cstring>
+
+
+namespace ti_sdk {
+
+namespace {
+constexpr uint8_t kSlipEnd = 0xC0;
+constexpr uint8_t kSlipEsc = 0xDB;
+constexpr uint8_t kSlipEscEnd = 0xDC;
+constexpr uint8_t kSlipEscEsc = 0xDD;
+} // namespace
+
+FrameDecoder::FrameDecoder(FramingMode mode, FrameCallback callback,
+                           size_t maxFrameSize)
+    : mode_(mode), callback_(std::move(callback)),
+      maxFrameSize_(maxFrameSize),
+      delimiter_(mode == FramingMode::LINE   ? '\n'
+                 : mode == FramingMode::SLIP ? kSlipEnd
+                                             : 0) {}
+
+void FrameDecoder::feed(const uint8_t *data, size_t length) {
+  while (length > 0) {
+    auto *end = static_cast<const uint8_t *>(
+        std::memchr(data, delimiter_, length));
+    size_t size = end ? static_cast<size_t>(end - data) : length;
+
+    if (discarding_) {
+      // Nothing to keep until the oversized frame ends
+    } else if (partial_.size() + size > maxFrameSize_) {
+      ++stats_.oversized;
+      partial_.clear();
+      discarding_ = true;
+    } else if (!end) {
+      partial_.insert(partial_.end(), data, data + size);
+    } else if (partial_.empty()) {
+      emit(data, size);
+    } else {
+      partial_.insert(partial_.end(), data, data + size);
+      emit(partial_.data(), partial_.size());
+      partial_.clear();
+    }
+
+    if (!end)
+      return;
+    discarding_ = false;
+    data = end + 1;
+    length -= size + 1;
+  }
+}
+
+void FrameDecoder::reset() {
+  partial_.clear();
+  discarding_ = false;
+}
+
+void FrameDecoder::emit(const uint8_t *data, size_t size) {
+  switch (mode_) {
+  case FramingMode::LINE:
+    if (size > 0 && data[size - 1] == '\r')
+      --size;
+    if (size > 0) {
+      ++stats_.frames;
+      callback_(data, size);
+    }
+    break;
+  case FramingMode::SLIP:
+    emitSlip(data, size);
+    break;
+  case FramingMode::COBS:
+    emitCobs(data, size);
+    break;
+  }
+}
+
+void FrameDecoder::emitSlip(const uint8_t *data, size_t size) {
+  if (size == 0)
+    return; // Back-to-back END bytes separate nothing
+
+  auto *escape =
+      static_cast<const uint8_t *>(std::memchr(data, kSlipEsc, size));
+  if (!escape) {
+    ++stats_.frames;
+    callback_(data, size);
+    return;
+  }
+
+  // Copy the runs between escapes
+  scratch_.clear();
+  const uint8_t *end = data + size;
+  while (escape) {
+    scratch_.insert(scratch_.end(), data, escape);
+    if (escape + 1 == end ||
+        (escape[1] != kSlipEscEnd && escape[1] != kSlipEscEsc)) {
+      ++stats_.errors;
+      return;
+    }
+    scratch_.push_back(escape[1] == kSlipEscEnd ? kSlipEnd : kSlipEsc);
+    data = escape + 2;
+    escape = static_cast<const uint8_t *>(
+        std::memchr(data, kSlipEsc, static_cast<size_t>(end - data)));
+  }
+  scratch_.insert(scratch_.end(), data, end);
+
+  ++stats_.frames;
+  callback_(scratch_.data(), scratch_.size());
+}
+
+void FrameDecoder::emitCobs(const uint8_t *data, size_t size) {
+  if (size == 0)
+    return;
+
+  // Each code byte gives the distance to the next zero; 0xFF marks a full
+  // block without a zero
+  scratch_.resize(size);
+  size_t in = 0;
+  size_t out = 0;
+  while (in < size) {
+    uint8_t code = data[in++];
+    size_t run = code - 1u;
+    if (code == 0 || in + run > size) {
+      ++stats_.errors;
+      return;
+    }
+    std::memcpy(&scratch_[out], data + in, run);
+    in += run;
+    out += run;
+    if (code != 0xFF && in < size)
+      scratch_[out++] = 0;
+  }
+
+  ++stats_.frames;
+  callback_(scratch_.data(), out);
+}
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,58 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace ti_sdk {
+
+enum class FramingMode {
+  LINE, // text lines ending in \n, a trailing \r is stripped
+  SLIP, // RFC 1055 frames delimited by 0xC0
+  COBS  // consistent overhead byte stuffing, frames delimited by 0x00
+};
+
+// Splits a byte stream into frames. Delimiters are located with memchr
+// over whole input spans, and frames that arrive in one piece and need no
+// unescaping are handed to the callback straight from the input without
+// copying. Frames longer than maxFrameSize are dropped.
+class FrameDecoder {
+public:
+  // Called with a decoded frame, valid only during the call
+  using FrameCallback = std::function<void(const uint8_t *data, size_t size)>;
+
+  struct Stats {
+    uint64_t frames;    // frames delivered
+    uint64_t errors;    // frames dropped for invalid encoding
+    uint64_t oversized; // frames dropped for exceeding maxFrameSize
+  };
+
+  FrameDecoder(FramingMode mode, FrameCallback callback,
+               size_t maxFrameSize = 4096);
+
+  // Decode a span of the stream
+  void feed(const uint8_t *data, size_t length);
+
+  // Drop a partially received frame
+  void reset();
+
+  FramingMode getMode() const { return mode_; }
+  Stats getStats() const { return stats_; }
+
+private:
+  void emit(const uint8_t *data, size_t size);
+  void emitSlip(const uint8_t *data, size_t size);
+  void emitCobs(const uint8_t *data, size_t size);
+
+  FramingMode mode_;
+  FrameCallback callback_;
+  size_t maxFrameSize_;
+  uint8_t delimiter_;
+  std::vector<uint8_t> partial_; // start of a frame split across feeds
+  std::vector<uint8_t> scratch_; // unescaped frame
+  bool discarding_ = false;      // skipping the rest of an oversized frame
+  Stats stats_{};
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -1,7 +1,12 @@
 #include "gpio.hpp"
+#include "interrupt.hpp"
+#include "logic_analyzer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
-#include <unordered_map>
+#include <vector>
 
 
 using json = nlohmann::json;
@@ -9,9 +14,19 @@ using json = nlohmann::json;
 namespace ti_sdk {
 
 namespace {
-struct PinConfig {
-  PinMode mode;
-  PinState state;
+// One cache line per port so that threads driving different ports never
+// share a line. Every pin is one bit of the port's words, mirroring the
+// PxDIR/PxOUT/PxREN register layout of the real parts.
+struct alignas(64) PortState {
+  std::atomic<uint32_t> configured{0};     // pins configured by configurePin
+  std::atomic<uint32_t> output{0};         // pins in OUTPUT mode
+  std::atomic<uint32_t> pullUp{0};         // pins in INPUT_PULLUP mode
+  std::atomic<uint32_t> pullDown{0};       // pins in INPUT_PULLDOWN mode
+  std::atomic<uint32_t> driven{0};         // inputs driven by a stimulus
+  std::atomic<uint32_t> state{0};          // pin levels (1 = HIGH)
+  std::atomic<uint32_t> risingEdge{0};     // pins detecting rising edges
+  std::atomic<uint32_t> fallingEdge{0};    // pins detecting falling edges
+  std::atomic<uint32_t> interruptFlags{0}; // latched edges
 };
 
 using PinId = uint32_t;
@@ -20,90 +35,391 @@ PinId makePinId(uint8_t port, uint8_t pin) {
   return (static_cast<uint32_t>(port) << 8) | pin;
 }
 
-std::unordered_map<PinId, PinConfig> pin_configs;
+constexpr GPIOConfig kDefaultConfig{
+    16,   // numPorts
+    32,   // pinsPerPort
+    true, // hasInterrupts
+    true, // hasPullUp
+    true  // hasPullDown
+};
+
+// Enough ports for any layout (numPorts is 8 bits wide)
+constexpr size_t kMaxPorts = 256;
+
+// The port table is allocated once for every possible port and never
+// moves, so lock-free pin operations cannot see it freed. It is only
+// cleared by initialize/restoreState (under gpio_mutex).
+GPIOConfig gpio_config = kDefaultConfig;
+std::unique_ptr<PortState[]> ports = std::make_unique<PortState[]>(kMaxPorts);
 std::mutex gpio_mutex;
-bool initialized = false;
+std::atomic<bool> initialized{false};
+
+bool validConfig(const GPIOConfig &config) {
+  return config.numPorts > 0 && config.pinsPerPort > 0 &&
+         config.pinsPerPort <= 32;
+}
+
+void resetPorts(const GPIOConfig &config) {
+  // Clear the old layout too, so ports it used start clean if they come
+  // back into use
+  size_t count = std::max(config.numPorts, gpio_config.numPorts);
+  for (size_t i = 0; i < count; ++i) {
+    ports[i].configured.store(0, std::memory_order_relaxed);
+    ports[i].output.store(0, std::memory_order_relaxed);
+    ports[i].pullUp.store(0, std::memory_order_relaxed);
+    ports[i].pullDown.store(0, std::memory_order_relaxed);
+    ports[i].driven.store(0, std::memory_order_relaxed);
+    ports[i].state.store(0, std::memory_order_relaxed);
+    ports[i].risingEdge.store(0, std::memory_order_relaxed);
+    ports[i].fallingEdge.store(0, std::memory_order_relaxed);
+    ports[i].interruptFlags.store(0, std::memory_order_relaxed);
+  }
+  gpio_config = config;
+}
+
+// Returns the port holding the pin, or nullptr if the pin is out of range
+PortState *findPort(uint8_t port, uint8_t pin) {
+  if (port >= gpio_config.numPorts || pin >= gpio_config.pinsPerPort)
+    return nullptr;
+  return &ports[port];
+}
+
+// Returns the port if every pin in mask is an output, or nullptr otherwise
+PortState *findOutputPort(uint8_t port, uint32_t mask) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      port >= gpio_config.numPorts)
+    return nullptr;
+
+  PortState *p = &ports[port];
+  if ((p->output.load(std::memory_order_acquire) & mask) != mask)
+    return nullptr;
+  return p;
+}
+
+// Latch and raise the edges enabled on a port for a level transition.
+// Called after the port's level word has been updated, never with
+// gpio_mutex held.
+void raiseEdges(uint8_t port, PortState &p, uint32_t previous,
+                uint32_t current) {
+  uint32_t changed = previous ^ current;
+  uint32_t risingEnabled = p.risingEdge.load(std::memory_order_relaxed);
+  uint32_t fallingEnabled = p.fallingEdge.load(std::memory_order_relaxed);
+  uint32_t rising = changed & current & risingEnabled;
+  uint32_t falling = changed & ~current & fallingEnabled;
+  if (!(rising | falling))
+    return;
+
+  p.interruptFlags.fetch_or(rising | falling, std::memory_order_acq_rel);
+
+  uint32_t both = risingEnabled & fallingEnabled;
+  auto &interrupts = InterruptManager::getInstance();
+  if ((rising | falling) & both)
+    interrupts.triggerInterrupt(InterruptType::GPIO_CHANGE, port);
+  if (rising & ~both)
+    interrupts.triggerInterrupt(InterruptType::GPIO_RISING, port);
+  if (falling & ~both)
+    interrupts.triggerInterrupt(InterruptType::GPIO_FALLING, port);
+}
+
+// Publish a level transition of a port to the logic analyzer and the edge
+// detector
+void notifyTransition(uint8_t port, PortState &p, uint32_t previous,
+                      uint32_t current) {
+  if (previous == current)
+    return;
+
+  LogicAnalyzer::record(port, previous, current);
+  raiseEdges(port, p, previous, current);
+}
+
+// Returns the port if every pin in mask is a configured input, or nullptr
+// otherwise
+PortState *findInputPort(uint8_t port, uint32_t mask) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      port >= gpio_config.numPorts)
+    return nullptr;
+
+  PortState *p = &ports[port];
+  uint32_t inputs = p->configured.load(std::memory_order_acquire) &
+                    ~p->output.load(std::memory_order_acquire);
+  if ((inputs & mask) != mask)
+    return nullptr;
+  return p;
+}
+
+// Atomically replace the masked bits of a port's level word, returning the
+// previous word
+uint32_t exchangeLevels(PortState &p, uint32_t mask, uint32_t value) {
+  uint32_t previous = p.state.load(std::memory_order_relaxed);
+  while (!p.state.compare_exchange_weak(previous,
+                                        (previous & ~mask) | (value & mask),
+                                        std::memory_order_acq_rel)) {
+  }
+  return previous;
+}
+
+PinMode modeOf(const PortState &p, uint32_t bit) {
+  if (p.output.load(std::memory_order_relaxed) & bit)
+    return PinMode::OUTPUT;
+  if (p.pullUp.load(std::memory_order_relaxed) & bit)
+    return PinMode::INPUT_PULLUP;
+  if (p.pullDown.load(std::memory_order_relaxed) & bit)
+    return PinMode::INPUT_PULLDOWN;
+  return PinMode::INPUT;
+}
+
+void setMode(PortState &p, uint32_t bit, PinMode mode) {
+  auto assign = [bit](std::atomic<uint32_t> &word, bool set) {
+    if (set)
+      word.fetch_or(bit, std::memory_order_relaxed);
+    else
+      word.fetch_and(~bit, std::memory_order_relaxed);
+  };
+  assign(p.output, mode == PinMode::OUTPUT);
+  assign(p.pullUp, mode == PinMode::INPUT_PULLUP);
+  assign(p.pullDown, mode == PinMode::INPUT_PULLDOWN);
+  p.configured.fetch_or(bit, std::memory_order_release);
+}
 } // namespace
 
-bool GPIO::initialize() {
+bool GPIO::initialize() { return initialize(kDefaultConfig); }
+
+bool GPIO::initialize(const GPIOConfig &config) {
+  if (!validConfig(config))
+    return false;
+
   std::lock_guard<std::mutex> lock(gpio_mutex);
-  initialized = true;
-  pin_configs.clear();
+  resetPorts(config);
+  initialized.store(true, std::memory_order_release);
   return true;
 }
 
+const GPIOConfig &GPIO::getConfig() { return gpio_config; }
+
 bool GPIO::configurePin(uint8_t port, uint8_t pin, PinMode mode) {
-  if (!initialized)
+  if (!initialized.load(std::memory_order_acquire))
     return false;
 
-  std::lock_guard<std::mutex> lock(gpio_mutex);
-  pin_configs[makePinId(port, pin)] = PinConfig{mode, PinState::LOW};
+  if ((mode == PinMode::INPUT_PULLUP && !gpio_config.hasPullUp) ||
+      (mode == PinMode::INPUT_PULLDOWN && !gpio_config.hasPullDown))
+    return false;
+
+  PortState *p;
+  uint32_t bit = 1u << pin;
+  uint32_t level = mode == PinMode::INPUT_PULLUP ? bit : 0;
+  uint32_t previous;
+  {
+    std::lock_guard<std::mutex> lock(gpio_mutex);
+    p = findPort(port, pin);
+    if (!p)
+      return false;
+
+    // Outputs start LOW; inputs idle at their pull level until driven
+    setMode(*p, bit, mode);
+    p->driven.fetch_and(~bit, std::memory_order_relaxed);
+    previous = exchangeLevels(*p, bit, level);
+  }
+
+  notifyTransition(port, *p, previous, (previous & ~bit) | level);
   return true;
 }
 
-bool GPIO::writePin(uint8_t port, uint8_t pin, PinState state) {
-  if (!initialized)
-    return false;
+PinMode GPIO::getPinMode(uint8_t port, uint8_t pin) {
+  if (!initialized.load(std::memory_order_acquire))
+    return PinMode::INPUT;
 
-  std::lock_guard<std::mutex> lock(gpio_mutex);
-  auto id = makePinId(port, pin);
-  auto it = pin_configs.find(id);
+  PortState *p = findPort(port, pin);
+  if (!p)
+    return PinMode::INPUT;
+
+  return modeOf(*p, 1u << pin);
+}
 
-  if (it == pin_configs.end() || it->second.mode != PinMode::OUTPUT) {
+bool GPIO::writePin(uint8_t port, uint8_t pin, PinState state) {
+  if (pin >= gpio_config.pinsPerPort)
     return false;
-  }
 
-  it->second.state = state;
-  return true;
+  uint32_t bit = 1u << pin;
+  return state == PinState::HIGH ? setPins(port, bit) : clearPins(port, bit);
 }
 
 PinState GPIO::readPin(uint8_t port, uint8_t pin) {
-  if (!initialized)
+  if (!initialized.load(std::memory_order_acquire))
     return PinState::LOW;
 
-  std::lock_guard<std::mutex> lock(gpio_mutex);
-  auto id = makePinId(port, pin);
-  auto it = pin_configs.find(id);
-
-  if (it == pin_configs.end()) {
+  PortState *p = findPort(port, pin);
+  if (!p) {
     return PinState::LOW;
   }
 
-  return it->second.state;
+  return (p->state.load(std::memory_order_acquire) & (1u << pin))
+             ? PinState::HIGH
+             : PinState::LOW;
 }
 
 bool GPIO::togglePin(uint8_t port, uint8_t pin) {
-  if (!initialized)
+  if (pin >= gpio_config.pinsPerPort)
     return false;
 
-  std::lock_guard<std::mutex> lock(gpio_mutex);
-  auto id = makePinId(port, pin);
-  auto it = pin_configs.find(id);
+  return togglePins(port, 1u << pin);
+}
 
-  if (it == pin_configs.end() || it->second.mode != PinMode::OUTPUT) {
+bool GPIO::writePortMasked(uint8_t port, uint32_t mask, uint32_t value) {
+  PortState *p = findOutputPort(port, mask);
+  if (!p)
     return false;
-  }
 
-  it->second.state =
-      (it->second.state == PinState::HIGH) ? PinState::LOW : PinState::HIGH;
+  uint32_t previous = exchangeLevels(*p, mask, value);
+  notifyTransition(port, *p, previous, (previous & ~mask) | (value & mask));
   return true;
 }
 
+bool GPIO::setPins(uint8_t port, uint32_t mask) {
+  PortState *p = findOutputPort(port, mask);
+  if (!p)
+    return false;
+
+  uint32_t previous = p->state.fetch_or(mask, std::memory_order_acq_rel);
+  notifyTransition(port, *p, previous, previous | mask);
+  return true;
+}
+
+bool GPIO::clearPins(uint8_t port, uint32_t mask) {
+  PortState *p = findOutputPort(port, mask);
+  if (!p)
+    return false;
+
+  uint32_t previous = p->state.fetch_and(~mask, std::memory_order_acq_rel);
+  notifyTransition(port, *p, previous, previous & ~mask);
+  return true;
+}
+
+bool GPIO::togglePins(uint8_t port, uint32_t mask) {
+  PortState *p = findOutputPort(port, mask);
+  if (!p)
+    return false;
+
+  uint32_t previous = p->state.fetch_xor(mask, std::memory_order_acq_rel);
+  notifyTransition(port, *p, previous, previous ^ mask);
+  return true;
+}
+
+bool GPIO::driveInputs(uint8_t port, uint32_t mask, uint32_t value) {
+  PortState *p = findInputPort(port, mask);
+  if (!p)
+    return false;
+
+  p->driven.fetch_or(mask, std::memory_order_relaxed);
+  uint32_t previous = exchangeLevels(*p, mask, value);
+  notifyTransition(port, *p, previous, (previous & ~mask) | (value & mask));
+  return true;
+}
+
+bool GPIO::releaseInputs(uint8_t port, uint32_t mask) {
+  PortState *p = findInputPort(port, mask);
+  if (!p)
+    return false;
+
+  p->driven.fetch_and(~mask, std::memory_order_relaxed);
+  uint32_t idle = p->pullUp.load(std::memory_order_relaxed);
+  uint32_t previous = exchangeLevels(*p, mask, idle);
+  notifyTransition(port, *p, previous, (previous & ~mask) | (idle & mask));
+  return true;
+}
+
+uint32_t GPIO::readPort(uint8_t port) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      port >= gpio_config.numPorts)
+    return 0;
+
+  return ports[port].state.load(std::memory_order_acquire);
+}
+
+bool GPIO::enableInterrupt(uint8_t port, uint8_t pin, EdgeTrigger edge) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      !gpio_config.hasInterrupts)
+    return false;
+
+  PortState *p = findPort(port, pin);
+  if (!p)
+    return false;
+
+  uint32_t bit = 1u << pin;
+  if (edge == EdgeTrigger::FALLING)
+    p->risingEdge.fetch_and(~bit, std::memory_order_relaxed);
+  else
+    p->risingEdge.fetch_or(bit, std::memory_order_relaxed);
+  if (edge == EdgeTrigger::RISING)
+    p->fallingEdge.fetch_and(~bit, std::memory_order_relaxed);
+  else
+    p->fallingEdge.fetch_or(bit, std::memory_order_relaxed);
+  return true;
+}
+
+bool GPIO::disableInterrupt(uint8_t port, uint8_t pin) {
+  if (!initialized.load(std::memory_order_acquire))
+    return false;
+
+  PortState *p = findPort(port, pin);
+  if (!p)
+    return false;
+
+  uint32_t bit = 1u << pin;
+  p->risingEdge.fetch_and(~bit, std::memory_order_relaxed);
+  p->fallingEdge.fetch_and(~bit, std::memory_order_relaxed);
+  p->interruptFlags.fetch_and(~bit, std::memory_order_relaxed);
+  return true;
+}
+
+uint32_t GPIO::getInterruptStatus(uint8_t port) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      port >= gpio_config.numPorts)
+    return 0;
+
+  return ports[port].interruptFlags.load(std::memory_order_acquire);
+}
+
+void GPIO::clearInterruptFlags(uint8_t port, uint32_t mask) {
+  if (!initialized.load(std::memory_order_acquire) ||
+      port >= gpio_config.numPorts)
+    return;
+
+  ports[port].interruptFlags.fetch_and(~mask, std::memory_order_acq_rel);
+}
+
 std::string GPIO::saveState() {
   std::lock_guard<std::mutex> lock(gpio_mutex);
 
   json state;
-  state["initialized"] = initialized;
+  state["initialized"] = initialized.load();
 
   json pins;
-  for (const auto &[id, config] : pin_configs) {
-    uint8_t port = id >> 8;
-    uint8_t pin = id & 0xFF;
-
-    pins[std::to_string(id)] = {{"port", port},
-                                {"pin", pin},
-                                {"mode", static_cast<int>(config.mode)},
-                                {"state", static_cast<int>(config.state)}};
+  for (uint8_t port = 0; port < gpio_config.numPorts; ++port) {
+    const PortState &p = ports[port];
+    uint32_t configured = p.configured.load(std::memory_order_acquire);
+    uint32_t levels = p.state.load(std::memory_order_acquire);
+
+    for (uint8_t pin = 0; pin < gpio_config.pinsPerPort; ++pin) {
+      uint32_t bit = 1u << pin;
+      if (!(configured & bit))
+        continue;
+
+      PinState level = (levels & bit) ? PinState::HIGH : PinState::LOW;
+      json &entry = pins[std::to_string(makePinId(port, pin))];
+      entry = {{"port", port},
+               {"pin", pin},
+               {"mode", static_cast<int>(modeOf(p, bit))},
+               {"state", static_cast<int>(level)}};
+
+      bool rising = p.risingEdge.load(std::memory_order_relaxed) & bit;
+      bool falling = p.fallingEdge.load(std::memory_order_relaxed) & bit;
+      if (rising || falling) {
+        EdgeTrigger edge = !falling  ? EdgeTrigger::RISING
+                           : !rising ? EdgeTrigger::FALLING
+                                     : EdgeTrigger::BOTH;
+        entry["edge"] = static_cast<int>(edge);
+      }
+    }
   }
   state["pins"] = pins;
 
@@ -113,19 +429,53 @@ std::string GPIO::saveState() {
 bool GPIO::restoreState(const std::string &state_str) {
   try {
     auto state = json::parse(state_str);
+    std::vector<uint32_t> previous;
+
+    {
+      std::lock_guard<std::mutex> lock(gpio_mutex);
+
+      // Validate every pin against the current layout before touching it
+      auto pins = state["pins"];
+      for (auto it = pins.begin(); it != pins.end(); ++it) {
+        uint8_t port = it.value()["port"];
+        uint8_t pin = it.value()["pin"];
+        if (!findPort(port, pin))
+          return false;
+      }
+
+      for (uint8_t port = 0; port < gpio_config.numPorts; ++port) {
+        previous.push_back(ports[port].state.load(std::memory_order_acquire));
+      }
+
+      resetPorts(gpio_config);
+      initialized.store(state["initialized"].get<bool>(),
+                        std::memory_order_release);
+
+      for (auto it = pins.begin(); it != pins.end(); ++it) {
+        uint8_t port = it.value()["port"];
+        uint8_t pin = it.value()["pin"];
+        PinMode mode = static_cast<PinMode>(it.value()["mode"]);
+        PinState state = static_cast<PinState>(it.value()["state"]);
+
+        uint32_t bit = 1u << pin;
+        setMode(ports[port], bit, mode);
+        if (state == PinState::HIGH)
+          ports[port].state.fetch_or(bit, std::memory_order_acq_rel);
+
+        if (it.value().contains("edge")) {
+          auto edge = static_cast<EdgeTrigger>(it.value()["edge"].get<int>());
+          if (edge != EdgeTrigger::FALLING)
+            ports[port].risingEdge.fetch_or(bit, std::memory_order_relaxed);
+          if (edge != EdgeTrigger::RISING)
+            ports[port].fallingEdge.fetch_or(bit, std::memory_order_relaxed);
+        }
+      }
+    }
 
-    std::lock_guard<std::mutex> lock(gpio_mutex);
-    initialized = state["initialized"];
-
-    pin_configs.clear();
-    auto pins = state["pins"];
-    for (auto it = pins.begin(); it != pins.end(); ++it) {
-      uint8_t port = it.value()["port"];
-      uint8_t pin = it.value()["pin"];
-      PinMode mode = static_cast<PinMode>(it.value()["mode"]);
-      PinState state = static_cast<PinState>(it.value()["state"]);
-
-      pin_configs[makePinId(port, pin)] = PinConfig{mode, state};
+    // Restored levels count as transitions for edge detection
+    for (uint8_t port = 0; port < previous.size(); ++port) {
+      notifyTransition(port, ports[port], previous[port],
+                 ports[port].state.load(std::memory_order_acquire));
     }
 
     return true;
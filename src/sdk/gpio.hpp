@@ -1,5 +1,6 @@
 #pragma once
 
+#include "device_profile.hpp"
 #include <cstdint>
 #include <string>
 
@@ -9,14 +10,27 @@ enum class PinMode { INPUT, OUTPUT, INPUT_PULLUP, INPUT_PULLDOWN };
 
 enum class PinState { LOW, HIGH };
 
+enum class EdgeTrigger { RISING, FALLING, BOTH };
+
 class GPIO {
 public:
-  // Initialize GPIO subsystem
+  // Initialize GPIO subsystem with the default port layout
   static bool initialize();
 
+  // Initialize GPIO subsystem with the port layout of a device profile
+  // (pinsPerPort must be between 1 and 32). Changing the layout requires a
+  // quiescent GPIO: no pin or port operation may run concurrently.
+  static bool initialize(const GPIOConfig &config);
+
+  // Get the active port layout
+  static const GPIOConfig &getConfig();
+
   // Configure a pin
   static bool configurePin(uint8_t port, uint8_t pin, PinMode mode);
 
+  // Get the mode a pin was configured with
+  static PinMode getPinMode(uint8_t port, uint8_t pin);
+
   // Write to a pin
   static bool writePin(uint8_t port, uint8_t pin, PinState state);
 
@@ -26,6 +40,47 @@ public:
   // Toggle pin state
   static bool togglePin(uint8_t port, uint8_t pin);
 
+  // Port-wide operations. Bit n of mask/value selects pin n of the port;
+  // every selected pin must be an output. Each call is one atomic update
+  // of the whole port.
+
+  // Write the masked pins to the matching bits of value
+  static bool writePortMasked(uint8_t port, uint32_t mask, uint32_t value);
+
+  // Drive the masked pins HIGH
+  static bool setPins(uint8_t port, uint32_t mask);
+
+  // Drive the masked pins LOW
+  static bool clearPins(uint8_t port, uint32_t mask);
+
+  // Toggle the masked pins
+  static bool togglePins(uint8_t port, uint32_t mask);
+
+  // Read the levels of all pins of a port
+  static uint32_t readPort(uint8_t port);
+
+  // Drive input pins from an external source. Bit n of mask selects pin n;
+  // every selected pin must be configured as an input.
+  static bool driveInputs(uint8_t port, uint32_t mask, uint32_t value);
+
+  // Stop driving input pins, returning them to their idle level (HIGH for
+  // INPUT_PULLUP, LOW otherwise)
+  static bool releaseInputs(uint8_t port, uint32_t mask);
+
+  // Enable edge detection on a pin. Detected edges latch the pin in the
+  // port's interrupt flags and raise GPIO_RISING, GPIO_FALLING or (for
+  // BOTH) GPIO_CHANGE on the InterruptManager with the port as source.
+  static bool enableInterrupt(uint8_t port, uint8_t pin, EdgeTrigger edge);
+
+  // Disable edge detection on a pin
+  static bool disableInterrupt(uint8_t port, uint8_t pin);
+
+  // Get the latched edge flags of a port
+  static uint32_t getInterruptStatus(uint8_t port);
+
+  // Clear latched edge flags of a port
+  static void clearInterruptFlags(uint8_t port, uint32_t mask);
+
   // Save current GPIO state to JSON
   static std::string saveState();
 
@@ -1,11 +1,18 @@
 #pragma once
 
 #include "logger.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstddef>
 #include <functional>
-#include <map>
 #include <mutex>
-#include <queue>
+#include <new>
 #include <thread>
+#include <type_traits>
+#include <utility>
 
 
 namespace ti_sdk {
@@ -17,101 +24,668 @@ enum class InterruptType {
   TIMER,
   ADC_COMPLETE,
   UART_RX,
-  UART_TX
+  UART_TX,
+  ADC_WINDOW
 };
 
+// Number of interrupt types, ADC_WINDOW being the last
+constexpr size_t kInterruptTypeCount =
+    static_cast<size_t>(InterruptType::ADC_WINDOW) + 1;
+
+// Type-erased void() callable stored inline, so attaching, copying and
+// calling a handler never allocates. Callables larger than kCapacity are
+// rejected at compile time; capture a pointer to larger state instead.
+class InlineHandler {
+public:
+  static constexpr size_t kCapacity = 4 * sizeof(void *);
+
+  InlineHandler() = default;
+  InlineHandler(std::nullptr_t) {}
+
+  template <typename F, typename Fn = typename std::decay<F>::type,
+            typename = typename std::enable_if<
+                !std::is_same<Fn, InlineHandler>::value>::type>
+  InlineHandler(F &&f) {
+    static_assert(sizeof(Fn) <= kCapacity,
+                  "interrupt handler too large to store inline");
+    static_assert(alignof(Fn) <= alignof(std::max_align_t),
+                  "interrupt handler over-aligned");
+    new (storage_) Fn(std::forward<F>(f));
+    ops_ = &OpsFor<Fn>::table;
+  }
+
+  InlineHandler(const InlineHandler &other) : ops_(other.ops_) {
+    if (ops_)
+      ops_->copy(storage_, other.storage_);
+  }
+
+  InlineHandler &operator=(const InlineHandler &other) {
+    if (this != &other) {
+      reset();
+      if (other.ops_)
+        other.ops_->copy(storage_, other.storage_);
+      ops_ = other.ops_;
+    }
+    return *this;
+  }
+
+  ~InlineHandler() { reset(); }
+
+  explicit operator bool() const { return ops_ != nullptr; }
+
+  void operator()() const { ops_->invoke(storage_); }
+
+private:
+  struct Ops {
+    void (*invoke)(void *);
+    void (*copy)(void *, const void *);
+    void (*destroy)(void *);
+  };
+
+  template <typename Fn> struct OpsFor {
+    static void invoke(void *f) { (*static_cast<Fn *>(f))(); }
+    static void copy(void *dst, const void *src) {
+      new (dst) Fn(*static_cast<const Fn *>(src));
+    }
+    static void destroy(void *f) { static_cast<Fn *>(f)->~Fn(); }
+    static constexpr Ops table{&invoke, &copy, &destroy};
+  };
+
+  void reset() {
+    if (ops_)
+      ops_->destroy(storage_);
+    ops_ = nullptr;
+  }
+
+  alignas(std::max_align_t) mutable unsigned char storage_[kCapacity];
+  const Ops *ops_ = nullptr;
+};
+
+// Emulated nested vectored interrupt controller. Every (type, source) pair
+// is an interrupt line with a priority, an enable bit and a pending bit.
+// Triggering a line only sets its pending bit with atomic operations, so
+// peripherals never wait for the dispatcher, and triggering a line that is
+// already pending coalesces into the pending dispatch. The dispatcher runs
+// the most urgent enabled pending line first. A handler that triggers a
+// line more urgent than its own runs that line's handler before returning,
+// like a preempting ISR. Pending storage is one bit per line, so storms
+// cannot grow memory, and per-line rate limits keep a flooding source from
+// starving the others.
+//
+// Handlers run on a pool of dispatch workers, one by default. Lines are
+// sharded over the workers by source, so all lines of a source (say the
+// rising, falling and change lines of a pin) run on one worker, never
+// concurrently and most urgent priority first, while other sources run in
+// parallel on the others. Lines of equal priority run in type order, not
+// in trigger order.
 class InterruptManager {
 public:
-  using InterruptHandler = std::function<void()>;
+  using InterruptHandler = InlineHandler;
+
+  static constexpr uint8_t kPriorityLevels = 8; // 0 is the most urgent
+  static constexpr size_t kMaxWorkers = 32;
+  static constexpr size_t kLatencyBuckets = 32;
+
+  // Trigger-to-handler latencies of dispatched interrupts
+  struct LatencyStats {
+    uint64_t count;   // handlers run
+    uint64_t totalNs; // sum of latencies
+    uint64_t maxNs;
+    // histogram[i] counts latencies in [2^i, 2^(i+1)) ns; bucket 0 also
+    // holds 0 ns and the last bucket everything above
+    std::array<uint64_t, kLatencyBuckets> histogram;
+  };
+
+  // Trigger outcomes. Once nothing is pending, triggered equals
+  // coalesced + dropped + dispatched, unless pending interrupts were
+  // cleared.
+  struct Counters {
+    uint64_t triggered;  // triggers of lines with a handler
+    uint64_t coalesced;  // merged into an interrupt already pending
+    uint64_t dropped;    // over the rate limit of the line
+    uint64_t dispatched; // handlers run
+  };
 
   static InterruptManager &getInstance() {
     static InterruptManager instance;
     return instance;
   }
 
-  // Register an interrupt handler
+  // Register an interrupt handler and enable its line
   bool attachInterrupt(InterruptType type, uint8_t source,
                        InterruptHandler handler) {
-    std::lock_guard<std::mutex> lock(mutex_);
     uint32_t id = makeInterruptId(type, source);
-    handlers_[id] = handler;
+    {
+      std::lock_guard<std::mutex> lock(handlersMutex_);
+      handlers_[id] = std::move(handler);
+    }
+    enabled_[id / 64].fetch_or(lineBit(id), std::memory_order_acq_rel);
+    attached_[id / 64].fetch_or(lineBit(id), std::memory_order_acq_rel);
     LOG_INFO("Interrupt handler attached for type: " +
              std::to_string(static_cast<int>(type)) +
              ", source: " + std::to_string(source));
     return true;
   }
 
-  // Remove an interrupt handler
+  // Remove an interrupt handler, dropping a pending interrupt of its line
   bool detachInterrupt(InterruptType type, uint8_t source) {
-    std::lock_guard<std::mutex> lock(mutex_);
     uint32_t id = makeInterruptId(type, source);
-    auto it = handlers_.find(id);
-    if (it != handlers_.end()) {
-      handlers_.erase(it);
-      LOG_INFO("Interrupt handler detached for type: " +
-               std::to_string(static_cast<int>(type)) +
-               ", source: " + std::to_string(source));
-      return true;
+    attached_[id / 64].fetch_and(~lineBit(id), std::memory_order_acq_rel);
+    clearPending(type, source);
+    {
+      std::lock_guard<std::mutex> lock(handlersMutex_);
+      if (!handlers_[id])
+        return false;
+      handlers_[id] = nullptr;
     }
-    return false;
+    LOG_INFO("Interrupt handler detached for type: " +
+             std::to_string(static_cast<int>(type)) +
+             ", source: " + std::to_string(source));
+    return true;
   }
 
-  // Trigger an interrupt
+  // Trigger an interrupt. Lines without a handler ignore triggers; lines
+  // that are disabled or masked stay pending until they may run. Neither
+  // allocates nor formats log messages, so it is cheap enough for hot
+  // peripheral paths.
   void triggerInterrupt(InterruptType type, uint8_t source) {
-    std::lock_guard<std::mutex> lock(mutex_);
     uint32_t id = makeInterruptId(type, source);
-    auto it = handlers_.find(id);
-    if (it != handlers_.end()) {
-      pendingInterrupts_.push(it->second);
-      LOG_DEBUG("Interrupt triggered for type: " +
-                std::to_string(static_cast<int>(type)) +
-                ", source: " + std::to_string(source));
+    size_t word = id / 64;
+    uint64_t bit = lineBit(id);
+    if (!(attached_[word].load(std::memory_order_acquire) & bit))
+      return;
+
+    // Each trigger bumps exactly one counter of its line
+    Line &line = lines_[id];
+    uint8_t level = line.priority.load(std::memory_order_relaxed);
+    auto &pending = pending_[level][word];
+    if (pending.load(std::memory_order_relaxed) & bit) {
+      line.coalesced.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    uint64_t now = nowNs();
+    if (!admit(line, now)) {
+      line.dropped.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    line.triggeredNs.store(now, std::memory_order_relaxed);
+    if (pending.fetch_or(bit, std::memory_order_acq_rel) & bit) {
+      // A concurrent trigger got there first
+      line.coalesced.fetch_add(1, std::memory_order_relaxed);
+      return;
+    }
+    line.raised.fetch_add(1, std::memory_order_relaxed);
+    pendingWords_[level].fetch_or(1u << word, std::memory_order_acq_rel);
+
+    // A handler raising a more urgent line of its own worker is preempted
+    // by it
+    Worker &worker = workers_[shardOf(id)];
+    if (currentWorker() == &worker && level < worker.activePriority) {
+      dispatch(worker, worker.activePriority);
+      return;
+    }
+    wakeWorker(worker);
+  }
+
+  // Set the priority of a line, 0 being the most urgent
+  bool setPriority(InterruptType type, uint8_t source, uint8_t priority) {
+    if (priority >= kPriorityLevels)
+      return false;
+
+    uint32_t id = makeInterruptId(type, source);
+    uint8_t previous = lines_[id].priority.exchange(priority);
+    // Move a pending interrupt to its new level
+    uint64_t bit = lineBit(id);
+    if (previous != priority &&
+        pending_[previous][id / 64].fetch_and(~bit) & bit) {
+      pending_[priority][id / 64].fetch_or(bit);
+      pendingWords_[priority].fetch_or(1u << (id / 64));
+      wakeWorker(workers_[shardOf(id)]);
     }
+    return true;
   }
 
-  // Process pending interrupts
-  void processInterrupts() {
-    while (running_) {
-      InterruptHandler handler;
-      {
-        std::lock_guard<std::mutex> lock(mutex_);
-        if (!pendingInterrupts_.empty()) {
-          handler = pendingInterrupts_.front();
-          pendingInterrupts_.pop();
+  uint8_t getPriority(InterruptType type, uint8_t source) {
+    return lines_[makeInterruptId(type, source)].priority.load();
+  }
+
+  // Limit a line to ratePerSecond dispatches on average, admitting bursts
+  // of up to burst triggers. Triggers over the limit are dropped. A rate
+  // of 0 removes the limit.
+  bool setRateLimit(InterruptType type, uint8_t source, uint32_t ratePerSecond,
+                    uint32_t burst = 1) {
+    if (burst == 0)
+      return false;
+
+    Line &line = lines_[makeInterruptId(type, source)];
+    uint64_t interval =
+        ratePerSecond ? std::max<uint64_t>(1000000000ull / ratePerSecond, 1)
+                      : 0;
+    line.intervalNs.store(0);
+    line.toleranceNs.store((burst - 1) * interval);
+    line.arrivalNs.store(0);
+    line.intervalNs.store(interval);
+    return true;
+  }
+
+  // Allow a line to be dispatched
+  void enableInterrupt(InterruptType type, uint8_t source) {
+    uint32_t id = makeInterruptId(type, source);
+    enabled_[id / 64].fetch_or(lineBit(id), std::memory_order_acq_rel);
+    wakeWorker(workers_[shardOf(id)]);
+  }
+
+  // Hold back a line; triggers still latch its pending bit
+  void disableInterrupt(InterruptType type, uint8_t source) {
+    uint32_t id = makeInterruptId(type, source);
+    enabled_[id / 64].fetch_and(~lineBit(id), std::memory_order_acq_rel);
+  }
+
+  bool isEnabled(InterruptType type, uint8_t source) {
+    uint32_t id = makeInterruptId(type, source);
+    return enabled_[id / 64].load() & lineBit(id);
+  }
+
+  // Check if a line has an interrupt waiting for dispatch
+  bool isPending(InterruptType type, uint8_t source) {
+    uint32_t id = makeInterruptId(type, source);
+    for (auto &level : pending_) {
+      if (level[id / 64].load() & lineBit(id))
+        return true;
+    }
+    return false;
+  }
+
+  // Drop the pending interrupt of a line
+  void clearPending(InterruptType type, uint8_t source) {
+    uint32_t id = makeInterruptId(type, source);
+    for (auto &level : pending_)
+      level[id / 64].fetch_and(~lineBit(id), std::memory_order_acq_rel);
+  }
+
+  // Hold back every line, like disabling interrupts on the CPU
+  void setGlobalMask(bool masked) {
+    globalMask_.store(masked, std::memory_order_release);
+    if (!masked) {
+      for (size_t i = 0; i < workerCount_; ++i)
+        wakeWorker(workers_[i]);
+    }
+  }
+
+  bool isGloballyMasked() { return globalMask_.load(); }
+
+  // Set the number of dispatch workers. Only possible while stopped.
+  bool setWorkerCount(size_t count) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_ || count == 0 || count > kMaxWorkers)
+      return false;
+
+    workerCount_ = count;
+    for (size_t w = 0; w < kMaxWorkers; ++w) {
+      for (size_t word = 0; word < kWords; ++word) {
+        uint64_t mask = 0;
+        for (uint32_t bit = 0; bit < 64; ++bit) {
+          if (shardOf(static_cast<uint32_t>(word * 64 + bit)) == w)
+            mask |= uint64_t{1} << bit;
         }
+        workers_[w].shardMask[word] = mask;
       }
-      if (handler) {
-        handler();
-      }
-      std::this_thread::sleep_for(std::chrono::milliseconds(1));
     }
+    return true;
   }
 
+  size_t getWorkerCount() { return workerCount_; }
+
   void start() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_)
+      return;
     running_ = true;
-    processingThread_ = std::thread(&InterruptManager::processInterrupts, this);
+    for (size_t i = 0; i < workerCount_; ++i) {
+      workers_[i].thread = std::thread(&InterruptManager::processInterrupts,
+                                       this, std::ref(workers_[i]));
+    }
   }
 
   void stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!running_)
+      return;
     running_ = false;
-    if (processingThread_.joinable()) {
-      processingThread_.join();
+    for (size_t i = 0; i < workerCount_; ++i) {
+      Worker &worker = workers_[i];
+      {
+        std::lock_guard<std::mutex> workerLock(worker.mutex);
+        worker.cv.notify_all();
+      }
+      if (worker.thread.joinable())
+        worker.thread.join();
+    }
+  }
+
+  // Get the latency statistics since start or the last reset
+  LatencyStats getLatencyStats() {
+    LatencyStats stats{};
+    stats.count = latencyCount_.load(std::memory_order_relaxed);
+    stats.totalNs = latencyTotalNs_.load(std::memory_order_relaxed);
+    stats.maxNs = latencyMaxNs_.load(std::memory_order_relaxed);
+    for (size_t i = 0; i < kLatencyBuckets; ++i)
+      stats.histogram[i] = latencyHistogram_[i].load(std::memory_order_relaxed);
+    return stats;
+  }
+
+  void resetLatencyStats() {
+    latencyCount_.store(0);
+    latencyTotalNs_.store(0);
+    latencyMaxNs_.store(0);
+    for (auto &bucket : latencyHistogram_)
+      bucket.store(0);
+  }
+
+  // Get the counters of one line since start or the last reset
+  Counters getCounters(InterruptType type, uint8_t source) {
+    return lines_[makeInterruptId(type, source)].counters();
+  }
+
+  // Get the counters summed over all lines
+  Counters getCounters() {
+    Counters total{};
+    for (auto &line : lines_) {
+      Counters counters = line.counters();
+      total.triggered += counters.triggered;
+      total.coalesced += counters.coalesced;
+      total.dropped += counters.dropped;
+      total.dispatched += counters.dispatched;
+    }
+    return total;
+  }
+
+  void resetCounters() {
+    for (auto &line : lines_) {
+      line.raised.store(0);
+      line.coalesced.store(0);
+      line.dropped.store(0);
+      line.dispatched.store(0);
     }
   }
 
 private:
-  InterruptManager() : running_(false) {}
+  static constexpr size_t kLines = kInterruptTypeCount * 256;
+  static constexpr size_t kWords = kLines / 64;
+  static_assert(kWords <= 32, "pendingWords_ holds one bit per word");
+
+  // Dispatch worker, running the lines of one shard
+  struct Worker {
+    std::array<uint64_t, kWords> shardMask; // lines of this worker
+    std::thread thread;
+    std::mutex mutex;
+    std::condition_variable cv; // signaled on wake-ups and stop
+    std::atomic<bool> sleeping{false};
+    bool wake = false;
+    uint8_t activePriority = kPriorityLevels; // of the running handler
+  };
+
+  // Per-line state, indexed by makeInterruptId
+  struct Line {
+    std::atomic<uint8_t> priority;
+    std::atomic<uint64_t> triggeredNs; // of the pending interrupt
+    // Rate limit, see admit()
+    std::atomic<uint64_t> intervalNs; // 0 without a limit
+    std::atomic<uint64_t> toleranceNs;
+    std::atomic<uint64_t> arrivalNs;
+    std::atomic<uint64_t> raised; // triggers that set the pending bit
+    std::atomic<uint64_t> coalesced;
+    std::atomic<uint64_t> dropped;
+    std::atomic<uint64_t> dispatched;
+
+    Counters counters() const {
+      Counters c{0, coalesced.load(std::memory_order_relaxed),
+                 dropped.load(std::memory_order_relaxed),
+                 dispatched.load(std::memory_order_relaxed)};
+      c.triggered =
+          raised.load(std::memory_order_relaxed) + c.coalesced + c.dropped;
+      return c;
+    }
+  };
+
+  InterruptManager() : running_(false) {
+    setWorkerCount(1);
+    for (auto &level : pending_) {
+      for (auto &word : level)
+        word.store(0);
+    }
+    for (size_t i = 0; i < kPriorityLevels; ++i)
+      pendingWords_[i].store(0);
+    for (size_t i = 0; i < kWords; ++i) {
+      enabled_[i].store(0);
+      attached_[i].store(0);
+    }
+    for (auto &line : lines_) {
+      line.priority.store(0);
+      line.triggeredNs.store(0);
+      line.intervalNs.store(0);
+      line.toleranceNs.store(0);
+      line.arrivalNs.store(0);
+    }
+    resetCounters();
+    resetLatencyStats();
+  }
   ~InterruptManager() { stop(); }
 
+  static uint64_t nowNs() {
+    return std::chrono::duration_cast<std::chrono::nanoseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+  }
+
+  static size_t latencyBucket(uint64_t ns) {
+    size_t bucket = 0;
+    while (ns > 1 && bucket < kLatencyBuckets - 1) {
+      ns >>= 1;
+      ++bucket;
+    }
+    return bucket;
+  }
+
+  // Generic cell rate algorithm: each admitted trigger moves the
+  // theoretical arrival time one interval ahead, and triggers arriving
+  // more than the burst tolerance before it are refused
+  static bool admit(Line &line, uint64_t now) {
+    uint64_t interval = line.intervalNs.load(std::memory_order_relaxed);
+    if (!interval)
+      return true;
+
+    uint64_t tolerance = line.toleranceNs.load(std::memory_order_relaxed);
+    uint64_t arrival = line.arrivalNs.load(std::memory_order_relaxed);
+    uint64_t next;
+    do {
+      uint64_t expected = std::max(arrival, now);
+      if (expected - now > tolerance)
+        return false;
+      next = expected + interval;
+    } while (!line.arrivalNs.compare_exchange_weak(arrival, next,
+                                                   std::memory_order_relaxed));
+    return true;
+  }
+
+  static unsigned lowestBit(uint64_t bits) {
+#if defined(__GNUC__)
+    return static_cast<unsigned>(__builtin_ctzll(bits));
+#else
+    unsigned index = 0;
+    while (!(bits & 1)) {
+      bits >>= 1;
+      ++index;
+    }
+    return index;
+#endif
+  }
+
+  static uint64_t lineBit(uint32_t id) { return uint64_t{1} << (id % 64); }
+
+  // Shard by source, the low byte of the id
+  size_t shardOf(uint32_t id) const {
+    return (id & 0xFF) % workerCount_.load(std::memory_order_relaxed);
+  }
+
+  // Worker running on the calling thread, if any
+  static Worker *&currentWorker() {
+    thread_local Worker *worker = nullptr;
+    return worker;
+  }
+
+  // Run the lines of a worker until stopped. Sleeps until interrupts are
+  // triggered and then runs every dispatchable handler in one pass.
+  void processInterrupts(Worker &worker) {
+    currentWorker() = &worker;
+    std::unique_lock<std::mutex> lock(worker.mutex);
+    while (running_) {
+      lock.unlock();
+      dispatch(worker, kPriorityLevels);
+      lock.lock();
+
+      // Triggers check sleeping after setting their pending bit, so
+      // either they see it or this check sees their interrupt
+      worker.sleeping.store(true, std::memory_order_relaxed);
+      std::atomic_thread_fence(std::memory_order_seq_cst);
+      if (running_ && !hasDispatchable(worker, kPriorityLevels))
+        worker.cv.wait(lock, [&] { return !running_ || worker.wake; });
+      worker.wake = false;
+      worker.sleeping.store(false, std::memory_order_relaxed);
+    }
+    currentWorker() = nullptr;
+  }
+
   uint32_t makeInterruptId(InterruptType type, uint8_t source) {
     return (static_cast<uint32_t>(type) << 8) | source;
   }
 
-  std::map<uint32_t, InterruptHandler> handlers_;
-  std::queue<InterruptHandler> pendingInterrupts_;
-  std::mutex mutex_;
-  std::thread processingThread_;
-  bool running_;
+  // Check for an enabled line of a worker pending with a priority below
+  // limit
+  bool hasDispatchable(const Worker &worker, uint8_t limit) {
+    if (globalMask_.load(std::memory_order_acquire))
+      return false;
+    for (uint8_t level = 0; level < limit; ++level) {
+      uint32_t words = pendingWords_[level].load(std::memory_order_acquire);
+      for (; words; words &= words - 1) {
+        unsigned word = lowestBit(words);
+        if (pending_[level][word].load(std::memory_order_acquire) &
+            enabled_[word].load(std::memory_order_acquire) &
+            worker.shardMask[word])
+          return true;
+      }
+    }
+    return false;
+  }
+
+  // Claim the most urgent enabled line of a worker pending with a priority
+  // below limit. Returns its id, or -1 if there is none. The trigger time
+  // is read while the line is still pending, since a new trigger may
+  // overwrite it as soon as the bit is cleared.
+  int takeNext(const Worker &worker, uint8_t limit, uint8_t &level,
+               uint64_t &triggeredNs) {
+    for (uint8_t l = 0; l < limit; ++l) {
+      uint32_t words = pendingWords_[l].load(std::memory_order_acquire);
+      for (; words; words &= words - 1) {
+        unsigned word = lowestBit(words);
+        auto &pending = pending_[l][word];
+        uint64_t ready = pending.load(std::memory_order_acquire) &
+                         enabled_[word].load(std::memory_order_acquire) &
+                         worker.shardMask[word];
+        if (!ready)
+          continue;
+
+        uint64_t bit = ready & (~ready + 1);
+        triggeredNs = lines_[word * 64 + lowestBit(bit)].triggeredNs.load(
+            std::memory_order_relaxed);
+        uint64_t previous = pending.fetch_and(~bit, std::memory_order_acq_rel);
+        if ((previous & ~bit) == 0) {
+          // Clear the summary bit, restoring it if a trigger raced us
+          pendingWords_[l].fetch_and(~(1u << word), std::memory_order_acq_rel);
+          if (pending.load(std::memory_order_acquire))
+            pendingWords_[l].fetch_or(1u << word, std::memory_order_acq_rel);
+        }
+        if (previous & bit) {
+          level = l;
+          return static_cast<int>(word * 64 + lowestBit(bit));
+        }
+      }
+    }
+    return -1;
+  }
+
+  // Run every enabled pending line of a worker with a priority below
+  // limit, most urgent first. Called on the worker's thread only.
+  void dispatch(Worker &worker, uint8_t limit) {
+    uint8_t level;
+    uint64_t triggeredNs;
+    int id;
+    while (!globalMask_.load(std::memory_order_acquire) &&
+           (id = takeNext(worker, limit, level, triggeredNs)) >= 0) {
+      InterruptHandler handler;
+      {
+        std::lock_guard<std::mutex> lock(handlersMutex_);
+        handler = handlers_[id];
+      }
+      if (!handler)
+        continue;
+
+      Line &line = lines_[id];
+      line.dispatched.fetch_add(1, std::memory_order_relaxed);
+      // A racing trigger may have stored a later time than ours
+      uint64_t now = nowNs();
+      uint64_t latency = now > triggeredNs ? now - triggeredNs : 0;
+      latencyTotalNs_.fetch_add(latency, std::memory_order_relaxed);
+      latencyHistogram_[latencyBucket(latency)].fetch_add(
+          1, std::memory_order_relaxed);
+      uint64_t max = latencyMaxNs_.load(std::memory_order_relaxed);
+      while (latency > max &&
+             !latencyMaxNs_.compare_exchange_weak(max, latency,
+                                                  std::memory_order_relaxed))
+        ;
+      latencyCount_.fetch_add(1, std::memory_order_relaxed);
+
+      uint8_t interrupted = worker.activePriority;
+      worker.activePriority = level;
+      handler();
+      worker.activePriority = interrupted;
+    }
+  }
+
+  // Wake a worker if it sleeps. Must follow setting a pending bit or
+  // making a line dispatchable.
+  void wakeWorker(Worker &worker) {
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (worker.sleeping.load(std::memory_order_relaxed)) {
+      std::lock_guard<std::mutex> lock(worker.mutex);
+      worker.wake = true;
+      worker.cv.notify_one();
+    }
+  }
+
+  // Lines, indexed by makeInterruptId
+  std::array<std::array<std::atomic<uint64_t>, kWords>, kPriorityLevels>
+      pending_;
+  // Words of pending_ that may have bits set, per level
+  std::array<std::atomic<uint32_t>, kPriorityLevels> pendingWords_;
+  std::array<std::atomic<uint64_t>, kWords> enabled_;
+  std::array<std::atomic<uint64_t>, kWords> attached_;
+  std::array<Line, kLines> lines_;
+  std::atomic<bool> globalMask_{false};
+
+  std::array<InterruptHandler, kLines> handlers_; // by makeInterruptId
+  std::mutex handlersMutex_;
+
+  // Dispatch workers
+  std::mutex mutex_; // serializes start, stop and setWorkerCount
+  std::array<Worker, kMaxWorkers> workers_;
+  std::atomic<size_t> workerCount_{0};
+  std::atomic<bool> running_;
+
+  std::atomic<uint64_t> latencyCount_;
+  std::atomic<uint64_t> latencyTotalNs_;
+  std::atomic<uint64_t> latencyMaxNs_;
+  std::array<std::atomic<uint64_t>, kLatencyBuckets> latencyHistogram_;
 };
 
 } // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,318 @@
+#include "logic_analyzer.hpp"
+#include "gpio.hpp"
+#include "scheduler.hpp"
+#include <array>
+#include <atomic>
+#include <charconv>
+#include <chrono>
+#include <fstream>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+
+namespace ti_sdk {
+
+namespace {
+// Flush formatted VCD text to the file in chunks of this size
+constexpr size_t kWriteChunk = 64 * 1024;
+
+// One writer count per possible port (numPorts is 8 bits wide)
+constexpr size_t kMaxPorts = 256;
+
+// Bounded multi-producer ring with per-slot sequence numbers: producers
+// claim a slot with one CAS on enqueuePos and publish it by storing its
+// sequence; the single drain thread consumes in order.
+struct Ring {
+  struct Slot {
+    std::atomic<uint64_t> sequence;
+    uint64_t timestampNs;
+    uint32_t previous;
+    uint32_t current;
+    uint8_t port;
+  };
+
+  explicit Ring(size_t capacity)
+      : mask(capacity - 1), slots(new Slot[capacity]) {}
+
+  void reset() {
+    for (size_t i = 0; i <= mask; ++i) {
+      slots[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    enqueuePos.store(0, std::memory_order_relaxed);
+    dequeuePos = 0;
+  }
+
+  bool push(uint8_t port, uint32_t previous, uint32_t current) {
+    uint64_t pos = enqueuePos.load(std::memory_order_relaxed);
+    Slot *slot;
+    while (true) {
+      slot = &slots[pos & mask];
+      uint64_t sequence = slot->sequence.load(std::memory_order_acquire);
+      int64_t diff = static_cast<int64_t>(sequence - pos);
+      if (diff == 0) {
+        if (enqueuePos.compare_exchange_weak(pos, pos + 1,
+                                             std::memory_order_relaxed))
+          break;
+      } else if (diff < 0) {
+        return false; // Full
+      } else {
+        pos = enqueuePos.load(std::memory_order_relaxed);
+      }
+    }
+
+    slot->timestampNs = TimerScheduler::nowNs();
+    slot->previous = previous;
+    slot->current = current;
+    slot->port = port;
+    slot->sequence.store(pos + 1, std::memory_order_release);
+    return true;
+  }
+
+  const Slot *front() const {
+    const Slot *slot = &slots[dequeuePos & mask];
+    if (slot->sequence.load(std::memory_order_acquire) != dequeuePos + 1)
+      return nullptr;
+    return slot;
+  }
+
+  void pop() {
+    slots[dequeuePos & mask].sequence.store(dequeuePos + mask + 1,
+                                            std::memory_order_release);
+    ++dequeuePos;
+  }
+
+  const size_t mask;
+  std::unique_ptr<Slot[]> slots;
+  alignas(64) std::atomic<uint64_t> enqueuePos{0};
+  alignas(64) uint64_t dequeuePos = 0;
+};
+
+// Identifier code of a VCD variable: base-94 over the printable characters
+std::string vcdIdentifier(size_t index) {
+  std::string id;
+  do {
+    id += static_cast<char>('!' + index % 94);
+    index /= 94;
+  } while (index);
+  return id;
+}
+
+class Capture {
+public:
+  static Capture &getInstance() {
+    static Capture instance;
+    return instance;
+  }
+
+  bool start(const std::string &filename, size_t capacity) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (active_.load())
+      return false;
+
+    file_.open(filename, std::ios::out | std::ios::trunc);
+    if (!file_)
+      return false;
+
+    size_t size = 1;
+    while (size < capacity)
+      size <<= 1;
+    // stop() waited for in-flight writers, so nobody touches the ring while
+    // it is reset or replaced
+    if (!ringStorage_ || ringStorage_->mask + 1 < size)
+      ringStorage_ = std::make_unique<Ring>(size);
+    ringStorage_->reset();
+    ring_.store(ringStorage_.get(), std::memory_order_release);
+    captured_ = 0;
+    dropped_.store(0, std::memory_order_relaxed);
+
+    writeHeader();
+    running_ = true;
+    active_.store(true, std::memory_order_release);
+    thread_ = std::thread(&Capture::drain, this);
+    return true;
+  }
+
+  bool stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!active_.load())
+      return false;
+
+    active_.store(false);
+    // Writers that saw the capture active finish their push before the
+    // drain thread's final pass and before a later start() resets the ring
+    for (const auto &writers : writers_) {
+      while (writers.count.load() != 0)
+        std::this_thread::yield();
+    }
+    running_ = false;
+    thread_.join();
+    file_.close();
+    return true;
+  }
+
+  void record(uint8_t port, uint32_t previous, uint32_t current) {
+    if (!active_.load(std::memory_order_acquire))
+      return;
+    // Register as in-flight, then recheck: either stop() sees the writer
+    // and waits, or the writer sees the capture stopped. Counts are per
+    // port so that ports driven from different threads do not share one.
+    auto &writers = writers_[port].count;
+    writers.fetch_add(1);
+    if (active_.load()) {
+      Ring *ring = ring_.load(std::memory_order_acquire);
+      if (!ring->push(port, previous, current))
+        dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+    writers.fetch_sub(1, std::memory_order_release);
+  }
+
+  bool isCapturing() const { return active_.load(); }
+
+  LogicAnalyzer::Stats getStats() const {
+    return LogicAnalyzer::Stats{captured_.load(std::memory_order_relaxed),
+                                dropped_.load(std::memory_order_relaxed)};
+  }
+
+private:
+  Capture() = default;
+  ~Capture() { stop(); }
+
+  void writeHeader() {
+    const GPIOConfig &config = GPIO::getConfig();
+    numPorts_ = config.numPorts;
+    pinsPerPort_ = config.pinsPerPort;
+    startNs_ = TimerScheduler::nowNs();
+    lastTimeNs_ = 0;
+    levels_.assign(numPorts_, 0);
+    identifiers_.clear();
+    for (size_t i = 0; i < size_t(numPorts_) * pinsPerPort_; ++i) {
+      identifiers_.push_back(vcdIdentifier(i));
+    }
+
+    file_ << "$version TI SDK Emulator logic analyzer $end\n"
+          << "$timescale 1ns $end\n"
+          << "$scope module gpio $end\n";
+    for (uint8_t port = 0; port < numPorts_; ++port) {
+      for (uint8_t pin = 0; pin < pinsPerPort_; ++pin) {
+        file_ << "$var wire 1 " << identifiers_[port * pinsPerPort_ + pin]
+              << " P" << static_cast<int>(port) << "_"
+              << static_cast<int>(pin) << " $end\n";
+      }
+    }
+    file_ << "$upscope $end\n$enddefinitions $end\n#0\n$dumpvars\n";
+    for (uint8_t port = 0; port < numPorts_; ++port) {
+      levels_[port] = GPIO::readPort(port);
+      for (uint8_t pin = 0; pin < pinsPerPort_; ++pin) {
+        file_ << ((levels_[port] >> pin) & 1)
+              << identifiers_[port * pinsPerPort_ + pin] << "\n";
+      }
+    }
+    file_ << "$end\n";
+  }
+
+  void drain() {
+    Ring *ring = ring_.load(std::memory_order_acquire);
+    std::string text;
+    text.reserve(2 * kWriteChunk);
+    while (true) {
+      bool finishing = !running_;
+      size_t drained = 0;
+      while (const Ring::Slot *slot = ring->front()) {
+        format(*slot, text);
+        ring->pop();
+        ++drained;
+        if (text.size() >= kWriteChunk) {
+          file_.write(text.data(), text.size());
+          text.clear();
+        }
+      }
+      captured_.fetch_add(drained, std::memory_order_relaxed);
+
+      if (finishing)
+        break;
+      if (!drained) {
+        file_.write(text.data(), text.size());
+        text.clear();
+        std::this_thread::sleep_for(std::chrono::milliseconds(1));
+      }
+    }
+    file_.write(text.data(), text.size());
+    file_.flush();
+  }
+
+  void format(const Ring::Slot &slot, std::string &text) {
+    if (slot.port >= numPorts_)
+      return;
+
+    // Writers on different threads may publish slightly out of order;
+    // VCD time must not go backwards
+    uint64_t time = slot.timestampNs > startNs_ ? slot.timestampNs - startNs_
+                                                : 0;
+    if (time > lastTimeNs_) {
+      lastTimeNs_ = time;
+      char digits[24];
+      auto end = std::to_chars(digits, digits + sizeof(digits), time).ptr;
+      text += '#';
+      text.append(digits, end);
+      text += '\n';
+    }
+
+    uint32_t changed = (slot.previous ^ slot.current) &
+                       (levels_[slot.port] ^ slot.current);
+    levels_[slot.port] ^= changed;
+    for (uint8_t pin = 0; changed; ++pin, changed >>= 1) {
+      if (changed & 1) {
+        text += ((slot.current >> pin) & 1) ? '1' : '0';
+        text += identifiers_[slot.port * pinsPerPort_ + pin];
+        text += '\n';
+      }
+    }
+  }
+
+  std::mutex mutex_; // serializes start/stop
+  std::atomic<bool> active_{false};
+  struct alignas(64) Writers {
+    std::atomic<uint32_t> count{0}; // record() calls inside push
+  };
+  std::array<Writers, kMaxPorts> writers_;
+  std::atomic<bool> running_{false};
+  std::thread thread_;
+  std::ofstream file_;
+  std::atomic<Ring *> ring_{nullptr};
+  std::unique_ptr<Ring> ringStorage_; // owns ring_
+  std::atomic<uint64_t> captured_{0};
+  std::atomic<uint64_t> dropped_{0};
+
+  // Drain thread state
+  uint8_t numPorts_ = 0;
+  uint8_t pinsPerPort_ = 0;
+  uint64_t startNs_ = 0;
+  uint64_t lastTimeNs_ = 0;
+  std::vector<uint32_t> levels_;
+  std::vector<std::string> identifiers_;
+};
+} // namespace
+
+bool LogicAnalyzer::start(const std::string &filename, size_t capacity) {
+  if (capacity == 0)
+    return false;
+  return Capture::getInstance().start(filename, capacity);
+}
+
+bool LogicAnalyzer::stop() { return Capture::getInstance().stop(); }
+
+bool LogicAnalyzer::isCapturing() {
+  return Capture::getInstance().isCapturing();
+}
+
+LogicAnalyzer::Stats LogicAnalyzer::getStats() {
+  return Capture::getInstance().getStats();
+}
+
+void LogicAnalyzer::record(uint8_t port, uint32_t previous, uint32_t current) {
+  Capture::getInstance().record(port, previous, current);
+}
+
+} // namespace ti_sdk
\ No newline at end of file
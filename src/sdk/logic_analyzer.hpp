@@ -0,0 +1,41 @@
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+
+namespace ti_sdk {
+
+// Records every GPIO level transition with a timestamp and streams the
+// trace to a VCD file (viewable in GTKWave). Writers only append to a
+// preallocated lock-free ring buffer; a background thread formats and
+// writes the file. When the ring is full, transitions are dropped and
+// counted rather than blocking the writer.
+class LogicAnalyzer {
+public:
+  struct Stats {
+    uint64_t captured; // transitions written to the file
+    uint64_t dropped;  // transitions lost because the ring was full
+  };
+
+  // Start capturing into a VCD file. The ring holds at least capacity
+  // transitions (rounded up to a power of two).
+  static bool start(const std::string &filename, size_t capacity = 1 << 16);
+
+  // Stop capturing, flushing all buffered transitions to the file
+  static bool stop();
+
+  // Check if a capture is running
+  static bool isCapturing();
+
+  // Get statistics of the current or last capture
+  static Stats getStats();
+
+  // Record a port transition. Called by GPIO after every level change.
+  static void record(uint8_t port, uint32_t previous, uint32_t current);
+
+private:
+  LogicAnalyzer() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,88 @@
+#pragma once
+
+#include <algorithm>
+#include <boost/interprocess/file_mapping.hpp>
+#include <boost/interprocess/mapped_region.hpp>
+#include <cstdint>
+#include <fstream>
+#include <string>
+
+namespace ti_sdk {
+
+// Read-only view of a file through a sliding memory-mapped window, so that
+// replaying multi-gigabyte recordings only ever maps windowSize bytes
+class MappedFile {
+public:
+  explicit MappedFile(size_t windowSize = 32 * 1024 * 1024)
+      : windowSize_(windowSize) {}
+
+  bool open(const std::string &filename) {
+    namespace bip = boost::interprocess;
+    close();
+    std::ifstream file(filename, std::ios::binary | std::ios::ate);
+    if (!file)
+      return false;
+
+    try {
+      bip::file_mapping mapping(filename.c_str(), bip::read_only);
+      mapping_.swap(mapping);
+      size_ = static_cast<uint64_t>(file.tellg());
+      return true;
+    } catch (const bip::interprocess_exception &) {
+      close();
+      return false;
+    }
+  }
+
+  void close() {
+    boost::interprocess::mapped_region().swap(region_);
+    boost::interprocess::file_mapping().swap(mapping_);
+    size_ = 0;
+    windowOffset_ = 0;
+  }
+
+  uint64_t size() const { return size_; }
+
+  // Get a pointer to the byte at offset, valid until the next call. At
+  // least min(minLength, size() - offset) bytes are readable from it; the
+  // exact count is stored in available.
+  const uint8_t *view(uint64_t offset, size_t minLength, size_t &available) {
+    namespace bip = boost::interprocess;
+    available = 0;
+    if (offset >= size_)
+      return nullptr;
+
+    uint64_t wanted = std::min<uint64_t>(minLength, size_ - offset);
+    uint64_t windowEnd = windowOffset_ + region_.get_size();
+    if (!region_.get_address() || offset < windowOffset_ ||
+        offset + wanted > windowEnd) {
+      uint64_t page = bip::mapped_region::get_page_size();
+      uint64_t start = offset - offset % page;
+      uint64_t length =
+          std::min<uint64_t>(std::max<uint64_t>(windowSize_, offset - start +
+                                                                 wanted),
+                             size_ - start);
+      try {
+        bip::mapped_region region(mapping_, bip::read_only, start, length);
+        region.advise(bip::mapped_region::advice_sequential);
+        region_.swap(region);
+        windowOffset_ = start;
+      } catch (const bip::interprocess_exception &) {
+        return nullptr;
+      }
+    }
+
+    available = windowOffset_ + region_.get_size() - offset;
+    return static_cast<const uint8_t *>(region_.get_address()) +
+           (offset - windowOffset_);
+  }
+
+private:
+  size_t windowSize_;
+  boost::interprocess::file_mapping mapping_;
+  boost::interprocess::mapped_region region_;
+  uint64_t size_ = 0;
+  uint64_t windowOffset_ = 0;
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,108 @@
+#pragma once
+
+#include <algorithm>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <type_traits>
+
+namespace ti_sdk {
+
+// Fixed-capacity single-producer/single-consumer ring. One thread may push
+// while another pops without any locking; the producer and consumer
+// indices live on separate cache lines and each side caches the other's
+// index so that bulk transfers touch shared state once per call.
+template <typename T> class SpscRing {
+  static_assert(std::is_trivially_copyable<T>::value,
+                "SpscRing elements are copied with std::copy");
+
+public:
+  explicit SpscRing(size_t capacity = 0) { reset(capacity); }
+
+  // Resize and empty the ring. Not safe while other threads use it.
+  void reset(size_t capacity) {
+    size_t storage = 1;
+    while (storage < capacity)
+      storage <<= 1;
+    buffer_.reset(new T[storage]);
+    mask_ = storage - 1;
+    capacity_ = capacity;
+    head_.store(0, std::memory_order_relaxed);
+    tail_.store(0, std::memory_order_relaxed);
+    cachedHead_ = 0;
+    cachedTail_ = 0;
+  }
+
+  size_t capacity() const { return capacity_; }
+
+  size_t size() const {
+    return head_.load(std::memory_order_acquire) -
+           tail_.load(std::memory_order_acquire);
+  }
+
+  bool empty() const { return size() == 0; }
+
+  // Producer side: append one element, returns false if full
+  bool push(const T &item) { return push(&item, 1) == 1; }
+
+  // Producer side: append up to count elements, returns how many fit
+  size_t push(const T *data, size_t count) {
+    size_t head = head_.load(std::memory_order_relaxed);
+    if (capacity_ - (head - cachedTail_) < count)
+      cachedTail_ = tail_.load(std::memory_order_acquire);
+    count = std::min(count, capacity_ - (head - cachedTail_));
+    if (count == 0)
+      return 0;
+
+    size_t first = std::min(count, mask_ + 1 - (head & mask_));
+    std::copy(data, data + first, &buffer_[head & mask_]);
+    std::copy(data + first, data + count, &buffer_[0]);
+    head_.store(head + count, std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side: remove one element, returns false if empty
+  bool pop(T &item) { return pop(&item, 1) == 1; }
+
+  // Consumer side: remove up to count elements, returns how many were read
+  size_t pop(T *data, size_t count) {
+    count = peek(data, count);
+    tail_.store(tail_.load(std::memory_order_relaxed) + count,
+                std::memory_order_release);
+    return count;
+  }
+
+  // Consumer side: copy up to count elements without removing them
+  size_t peek(T *data, size_t count) const {
+    size_t tail = tail_.load(std::memory_order_relaxed);
+    if (cachedHead_ - tail < count)
+      cachedHead_ = head_.load(std::memory_order_acquire);
+    count = std::min(count, cachedHead_ - tail);
+    if (count == 0)
+      return 0;
+
+    size_t first = std::min(count, mask_ + 1 - (tail & mask_));
+    std::copy(&buffer_[tail & mask_], &buffer_[tail & mask_] + first, data);
+    std::copy(&buffer_[0], &buffer_[0] + (count - first), data + first);
+    return count;
+  }
+
+  // Consumer side: drop everything currently buffered
+  void clear() {
+    tail_.store(head_.load(std::memory_order_acquire),
+                std::memory_order_release);
+  }
+
+private:
+  std::unique_ptr<T[]> buffer_;
+  size_t mask_ = 0;
+  size_t capacity_ = 0;
+
+  alignas(64) std::atomic<size_t> head_{0}; // written by the producer
+  size_t cachedTail_ = 0;                    // producer's view of tail_
+
+  alignas(64) std::atomic<size_t> tail_{0}; // written by the consumer
+  mutable size_t cachedHead_ = 0;            // consumer's view of head_
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,214 @@
+#include "scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <thread>
+#include <vector>
+
+namespace ti_sdk {
+
+namespace {
+constexpr uint64_t kSpinThresholdNs = TimerScheduler::kSpinThresholdNs;
+
+// Longest sleep of waitUntil, so that stop requests are seen promptly
+constexpr uint64_t kWaitSliceNs = 10000000;
+
+struct Timer {
+  TimerScheduler::Callback callback = nullptr;
+  void *context = nullptr;
+  bool active = false;
+  uint32_t generation = 0; // invalidates queued events when bumped
+  uint64_t deadlineNs = 0; // 0 while idle
+};
+
+struct Event {
+  uint64_t deadlineNs;
+  uint32_t timer;
+  uint32_t generation;
+
+  bool operator>(const Event &other) const {
+    return deadlineNs > other.deadlineNs;
+  }
+};
+
+class Scheduler {
+public:
+  static Scheduler &getInstance() {
+    static Scheduler instance;
+    return instance;
+  }
+
+  std::mutex mutex;
+  std::vector<Timer> timers;
+  std::vector<uint32_t> freeTimers;
+  TimerScheduler::Stats stats{};
+
+  // Queue a timer's deadline and make sure the thread runs. Requires mutex.
+  void schedule(uint32_t id, uint64_t deadlineNs) {
+    Timer &timer = timers[id];
+    if (timer.deadlineNs != 0 && timer.deadlineNs <= deadlineNs)
+      return;
+
+    timer.deadlineNs = deadlineNs;
+    events_.push(Event{deadlineNs, id, ++timer.generation});
+    if (!running_) {
+      running_ = true;
+      thread_ = std::thread(&Scheduler::run, this);
+    }
+    if (deadlineNs <= events_.top().deadlineNs) {
+      earlier_.store(true, std::memory_order_relaxed);
+      cv_.notify_one();
+    }
+  }
+
+private:
+  Scheduler() = default;
+
+  ~Scheduler() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running_ = false;
+    }
+    cv_.notify_one();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex);
+    while (running_) {
+      if (events_.empty()) {
+        cv_.wait(lock);
+        continue;
+      }
+
+      uint64_t now = TimerScheduler::nowNs();
+      uint64_t next = events_.top().deadlineNs;
+      if (next > now) {
+        if (next - now > kSpinThresholdNs) {
+          cv_.wait_for(lock,
+                       std::chrono::nanoseconds(next - now - kSpinThresholdNs));
+        } else {
+          // Spin without the lock so that add/wake/remove never wait for
+          // the scheduler, and stop early if an earlier deadline shows up
+          earlier_.store(false, std::memory_order_relaxed);
+          lock.unlock();
+          while (TimerScheduler::nowNs() < next &&
+                 !earlier_.load(std::memory_order_relaxed))
+            std::this_thread::yield();
+          lock.lock();
+        }
+        continue;
+      }
+
+      processDue(now);
+    }
+  }
+
+  // Run every timer whose deadline has passed
+  void processDue(uint64_t now) {
+    while (!events_.empty() && events_.top().deadlineNs <= now) {
+      Event event = events_.top();
+      events_.pop();
+
+      Timer &timer = timers[event.timer];
+      if (!timer.active || timer.generation != event.generation)
+        continue;
+
+      stats.maxLatenessNs =
+          std::max(stats.maxLatenessNs, now - event.deadlineNs);
+      ++stats.callbacks;
+
+      timer.deadlineNs = 0;
+      uint64_t next = timer.callback(timer.context, event.deadlineNs, now);
+      if (next != 0)
+        schedule(event.timer, next);
+    }
+  }
+
+  std::condition_variable cv_;
+  std::thread thread_;
+  bool running_ = false;
+  std::atomic<bool> earlier_{false}; // set when the next deadline moves up
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+};
+} // namespace
+
+uint64_t TimerScheduler::nowNs() {
+  return std::chrono::duration_cast<std::chrono::nanoseconds>(
+             std::chrono::steady_clock::now().time_since_epoch())
+      .count();
+}
+
+bool TimerScheduler::waitUntil(uint64_t deadlineNs,
+                               const std::atomic<bool> &stop) {
+  while (!stop) {
+    uint64_t now = nowNs();
+    if (now >= deadlineNs)
+      return true;
+    uint64_t remaining = deadlineNs - now;
+    if (remaining > kSpinThresholdNs) {
+      std::this_thread::sleep_for(std::chrono::nanoseconds(
+          std::min(remaining - kSpinThresholdNs, kWaitSliceNs)));
+    } else {
+      std::this_thread::yield();
+    }
+  }
+  return false;
+}
+
+uint32_t TimerScheduler::add(Callback callback, void *context) {
+  auto &scheduler = Scheduler::getInstance();
+  std::lock_guard<std::mutex> lock(scheduler.mutex);
+
+  uint32_t id;
+  if (!scheduler.freeTimers.empty()) {
+    id = scheduler.freeTimers.back();
+    scheduler.freeTimers.pop_back();
+  } else {
+    id = static_cast<uint32_t>(scheduler.timers.size());
+    scheduler.timers.emplace_back();
+  }
+
+  Timer &timer = scheduler.timers[id];
+  timer.callback = callback;
+  timer.context = context;
+  timer.active = true;
+  timer.deadlineNs = 0;
+  return id;
+}
+
+void TimerScheduler::remove(uint32_t id) {
+  auto &scheduler = Scheduler::getInstance();
+  std::lock_guard<std::mutex> lock(scheduler.mutex);
+  if (id >= scheduler.timers.size() || !scheduler.timers[id].active)
+    return;
+
+  Timer &timer = scheduler.timers[id];
+  timer.active = false;
+  timer.deadlineNs = 0;
+  ++timer.generation;
+  scheduler.freeTimers.push_back(id);
+}
+
+void TimerScheduler::wake(uint32_t id, uint64_t deadlineNs) {
+  auto &scheduler = Scheduler::getInstance();
+  std::lock_guard<std::mutex> lock(scheduler.mutex);
+  if (id >= scheduler.timers.size() || !scheduler.timers[id].active)
+    return;
+
+  scheduler.schedule(id, std::max<uint64_t>(deadlineNs, 1));
+}
+
+TimerScheduler::Stats TimerScheduler::getStats() {
+  auto &scheduler = Scheduler::getInstance();
+  std::lock_guard<std::mutex> lock(scheduler.mutex);
+  return scheduler.stats;
+}
+
+} // namespace ti_sdk
\ No newline at end of file
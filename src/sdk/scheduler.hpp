@@ -0,0 +1,53 @@
+#pragma once
+
+#include <atomic>
+#include <cstdint>
+
+namespace ti_sdk {
+
+// Shared timer thread for peripheral timing models. Timers fire on absolute
+// deadlines; a callback returns its next deadline, or 0 to go idle until
+// woken again. Callbacks run on the scheduler thread with the scheduler
+// lock held, so they must not call back into TimerScheduler.
+class TimerScheduler {
+public:
+  // Called with the deadline that fired and the current time
+  using Callback = uint64_t (*)(void *context, uint64_t deadlineNs,
+                                uint64_t nowNs);
+
+  struct Stats {
+    uint64_t callbacks;     // timer callbacks run
+    uint64_t maxLatenessNs; // worst delay between deadline and callback
+  };
+
+  // Waits shorter than this are spun instead of slept, since timed sleeps
+  // and condition variable waits overshoot by tens of microseconds
+  static constexpr uint64_t kSpinThresholdNs = 200000;
+
+  // Monotonic clock used for all deadlines
+  static uint64_t nowNs();
+
+  // Block the calling thread until deadlineNs, sleeping in slices and
+  // spinning for the last kSpinThresholdNs. Returns false as soon as stop
+  // is set.
+  static bool waitUntil(uint64_t deadlineNs, const std::atomic<bool> &stop);
+
+  // Create an idle timer, returns its id
+  static uint32_t add(Callback callback, void *context);
+
+  // Destroy a timer. Once this returns its callback is not running and will
+  // not run again.
+  static void remove(uint32_t timer);
+
+  // Schedule a timer at deadlineNs, or earlier if it is already scheduled
+  // for a later deadline
+  static void wake(uint32_t timer, uint64_t deadlineNs);
+
+  // Get scheduler statistics
+  static Stats getStats();
+
+private:
+  TimerScheduler() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
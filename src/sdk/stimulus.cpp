@@ -0,0 +1,327 @@
+#include "stimulus.hpp"
+#include "gpio.hpp"
+#include "mapped_file.hpp"
+#include "scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <cctype>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <mutex>
+#include <string_view>
+#include <thread>
+#include <unordered_map>
+#include <vector>
+
+
+namespace ti_sdk {
+
+namespace {
+// Longest VCD token read in one piece
+constexpr size_t kMaxToken = 4096;
+
+// Records mapped per view of a binary file
+constexpr size_t kRecordBatch = 64 * 1024;
+
+constexpr size_t kMaxPorts = 256;
+
+// Port updates collected for one timestamp
+struct PortBatch {
+  PortBatch()
+      : drive(kMaxPorts, 0), value(kMaxPorts, 0), release(kMaxPorts, 0) {}
+
+  void set(uint8_t port, uint32_t bit, bool high) {
+    touch(port);
+    drive[port] |= bit;
+    release[port] &= ~bit;
+    value[port] = high ? (value[port] | bit) : (value[port] & ~bit);
+  }
+
+  void unset(uint8_t port, uint32_t bit) {
+    touch(port);
+    release[port] |= bit;
+    drive[port] &= ~bit;
+  }
+
+  void touch(uint8_t port) {
+    if ((drive[port] | release[port]) == 0)
+      touched.push_back(port);
+  }
+
+  std::vector<uint32_t> drive;
+  std::vector<uint32_t> value;
+  std::vector<uint32_t> release;
+  std::vector<uint8_t> touched;
+};
+
+class Player {
+public:
+  static Player &getInstance() {
+    static Player instance;
+    return instance;
+  }
+
+  bool start(const std::string &filename, bool fast) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (running_.load())
+      return false;
+    if (thread_.joinable())
+      thread_.join();
+
+    if (!file_.open(filename))
+      return false;
+
+    fast_ = fast;
+    records_ = 0;
+    rejected_ = 0;
+    stopRequested_ = false;
+    running_ = true;
+    thread_ = std::thread(&Player::run, this);
+    return true;
+  }
+
+  bool stop() {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable())
+      return false;
+
+    bool wasRunning = running_.load();
+    stopRequested_ = true;
+    thread_.join();
+    return wasRunning;
+  }
+
+  bool isRunning() const { return running_.load(); }
+
+  StimulusPlayer::Stats getStats() const {
+    return StimulusPlayer::Stats{records_.load(), rejected_.load()};
+  }
+
+private:
+  Player() = default;
+  ~Player() { stop(); }
+
+  void run() {
+    size_t available;
+    const uint8_t *head = file_.view(0, sizeof(kStimulusMagic), available);
+    startNs_ = TimerScheduler::nowNs();
+    if (head && available >= sizeof(kStimulusMagic) &&
+        std::memcmp(head, kStimulusMagic, sizeof(kStimulusMagic)) == 0) {
+      playBinary();
+    } else {
+      playVcd();
+    }
+    file_.close();
+    running_ = false;
+  }
+
+  // Wait until a recording timestamp is due. Returns false if stopped.
+  bool waitFor(uint64_t timestampNs) {
+    if (fast_)
+      return !stopRequested_;
+    return TimerScheduler::waitUntil(startNs_ + timestampNs, stopRequested_);
+  }
+
+  void apply(uint8_t port, uint32_t drive, uint32_t value, uint32_t release) {
+    bool ok = true;
+    if (drive)
+      ok = GPIO::driveInputs(port, drive, value) && ok;
+    if (release)
+      ok = GPIO::releaseInputs(port, release) && ok;
+    if (ok)
+      ++records_;
+    else
+      ++rejected_;
+  }
+
+  void playBinary() {
+    uint64_t offset = sizeof(kStimulusMagic);
+    while (true) {
+      size_t available;
+      const uint8_t *data = file_.view(
+          offset, kRecordBatch * sizeof(StimulusRecord), available);
+      size_t count = data ? available / sizeof(StimulusRecord) : 0;
+      if (count == 0)
+        return;
+
+      for (size_t i = 0; i < count; ++i) {
+        StimulusRecord record;
+        std::memcpy(&record, data + i * sizeof(StimulusRecord),
+                    sizeof(record));
+        if (!waitFor(record.timestampNs))
+          return;
+        apply(record.port, record.mask, record.value, 0);
+      }
+      offset += count * sizeof(StimulusRecord);
+    }
+  }
+
+  // Next whitespace-separated token of the VCD file, or an empty view at
+  // the end. The view is valid until the next call.
+  std::string_view nextToken() {
+    while (true) {
+      size_t available;
+      const uint8_t *data = file_.view(offset_, kMaxToken, available);
+      if (!data)
+        return {};
+
+      size_t begin = 0;
+      while (begin < available && std::isspace(data[begin]))
+        ++begin;
+      if (begin == available) {
+        offset_ += available;
+        continue;
+      }
+
+      size_t end = begin;
+      while (end < available && !std::isspace(data[end]))
+        ++end;
+      offset_ += end;
+      return std::string_view(reinterpret_cast<const char *>(data) + begin,
+                              end - begin);
+    }
+  }
+
+  void skipToEnd() {
+    for (auto token = nextToken(); !token.empty() && token != "$end";
+         token = nextToken()) {
+    }
+  }
+
+  // Nanoseconds per VCD time unit from a $timescale declaration
+  double parseTimescale() {
+    std::string text;
+    for (auto token = nextToken(); !token.empty() && token != "$end";
+         token = nextToken()) {
+      text.append(token);
+    }
+
+    size_t digits = 0;
+    while (digits < text.size() && std::isdigit(text[digits]))
+      ++digits;
+    double magnitude = digits ? std::stod(text.substr(0, digits)) : 1.0;
+    std::string unit = text.substr(digits);
+    if (unit == "s")
+      return magnitude * 1e9;
+    if (unit == "ms")
+      return magnitude * 1e6;
+    if (unit == "us")
+      return magnitude * 1e3;
+    if (unit == "ps")
+      return magnitude * 1e-3;
+    if (unit == "fs")
+      return magnitude * 1e-6;
+    return magnitude; // ns
+  }
+
+  // Map a $var declaration named P<port>_<pin> to its pin
+  void parseVar(std::unordered_map<std::string, uint32_t> &pins) {
+    auto type = nextToken();
+    (void)type;
+    std::string width(nextToken());
+    std::string id(nextToken());
+    std::string reference(nextToken());
+    skipToEnd();
+
+    unsigned port, pin;
+    char trailing;
+    if (width == "1" &&
+        std::sscanf(reference.c_str(), "P%u_%u%c", &port, &pin, &trailing) ==
+            2 &&
+        port < kMaxPorts && pin < 32) {
+      pins[id] = (port << 8) | pin;
+    }
+  }
+
+  void playVcd() {
+    std::unordered_map<std::string, uint32_t> pins;
+    double scale = 1.0;
+    offset_ = 0;
+
+    // Header
+    for (auto token = nextToken(); !token.empty(); token = nextToken()) {
+      if (token == "$timescale") {
+        scale = parseTimescale();
+      } else if (token == "$var") {
+        parseVar(pins);
+      } else if (token == "$enddefinitions") {
+        skipToEnd();
+        break;
+      } else if (token[0] == '$') {
+        skipToEnd();
+      }
+    }
+
+    // Value changes, applied once per timestamp
+    PortBatch batch;
+    std::string id;
+    auto flush = [this, &batch] {
+      for (uint8_t port : batch.touched) {
+        apply(port, batch.drive[port], batch.value[port], batch.release[port]);
+        batch.drive[port] = 0;
+        batch.release[port] = 0;
+      }
+      batch.touched.clear();
+    };
+
+    for (auto token = nextToken(); !token.empty(); token = nextToken()) {
+      char kind = token[0];
+      if (kind == '#') {
+        flush();
+        uint64_t time = std::strtoull(std::string(token.substr(1)).c_str(),
+                                      nullptr, 10);
+        if (!waitFor(static_cast<uint64_t>(time * scale)))
+          return;
+      } else if (kind == '$') {
+        if (token == "$comment")
+          skipToEnd();
+        // $dumpvars, $dumpall, $dumpon, $dumpoff and $end frame values
+      } else if (kind == 'b' || kind == 'B' || kind == 'r' || kind == 'R') {
+        nextToken(); // Vector values are not GPIO pins
+      } else {
+        id.assign(token.substr(1));
+        auto it = pins.find(id);
+        if (it == pins.end())
+          continue;
+
+        uint8_t port = it->second >> 8;
+        uint32_t bit = 1u << (it->second & 0xFF);
+        if (kind == '0' || kind == '1')
+          batch.set(port, bit, kind == '1');
+        else
+          batch.unset(port, bit);
+      }
+    }
+    flush();
+  }
+
+  std::mutex mutex_; // serializes start/stop
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<uint64_t> records_{0};
+  std::atomic<uint64_t> rejected_{0};
+
+  // Replay thread state
+  MappedFile file_;
+  bool fast_ = false;
+  uint64_t startNs_ = 0;
+  uint64_t offset_ = 0;
+};
+} // namespace
+
+bool StimulusPlayer::start(const std::string &filename, bool fast) {
+  return Player::getInstance().start(filename, fast);
+}
+
+bool StimulusPlayer::stop() { return Player::getInstance().stop(); }
+
+bool StimulusPlayer::isRunning() { return Player::getInstance().isRunning(); }
+
+StimulusPlayer::Stats StimulusPlayer::getStats() {
+  return Player::getInstance().getStats();
+}
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,50 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ti_sdk {
+
+// Binary stimulus files start with this magic, followed by StimulusRecords
+// sorted by timestamp
+constexpr char kStimulusMagic[8] = {'G', 'P', 'I', 'O', 'S', 'T', 'I', 'M'};
+
+struct StimulusRecord {
+  uint64_t timestampNs; // time since the start of the recording
+  uint32_t mask;        // input pins driven by this record
+  uint32_t value;       // levels of the driven pins
+  uint8_t port;
+  uint8_t reserved[7];
+};
+
+static_assert(sizeof(StimulusRecord) == 24, "StimulusRecord must be packed");
+
+// Replays recorded external stimulus onto GPIO input pins. Files are
+// streamed through a sliding memory-mapped window, so memory use does not
+// depend on the recording size. Both the binary format above and VCD
+// traces (using the P<port>_<pin> names written by LogicAnalyzer) are
+// accepted; VCD x/z values release the pin to its idle level.
+class StimulusPlayer {
+public:
+  struct Stats {
+    uint64_t records;  // port updates applied
+    uint64_t rejected; // updates targeting pins that are not inputs
+  };
+
+  // Start replaying a file, at recorded timing or as fast as possible
+  static bool start(const std::string &filename, bool fast = false);
+
+  // Stop the replay
+  static bool stop();
+
+  // Check if a replay is running
+  static bool isRunning();
+
+  // Get statistics of the current or last replay
+  static Stats getStats();
+
+private:
+  StimulusPlayer() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
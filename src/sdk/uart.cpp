@@ -1,8 +1,17 @@
 #include "uart.hpp"
+#include "frame_decoder.hpp"
+#include "interrupt.hpp"
+#include "ring_buffer.hpp"
+#include "scheduler.hpp"
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <deque>
+#include <memory>
 #include <mutex>
 #include <nlohmann/json.hpp>
-#include <queue>
 #include <thread>
+#include <vector>
 
 
 using json = nlohmann::json;
@@ -10,101 +19,745 @@ using json = nlohmann::json;
 namespace ti_sdk {
 
 namespace {
-struct UARTState {
-  bool initialized;
-  uint32_t baudRate;
-  std::queue<uint8_t> rxBuffer;
-  std::queue<uint8_t> txBuffer;
+// Buffers are single-producer/single-consumer: firmware writes TX and reads
+// RX, the line side (injectRx/drainTx) fills RX and empties TX. Only
+// initialization, timing changes and state save/restore take the channel's
+// mutex; save/restore additionally require a quiescent channel.
+//
+// With timing enabled each direction gets a line ring and a scheduler
+// timer that moves bytes across at one byte per frame time:
+//   writeBuffer -> txBuffer -> [TX timer] -> txLine -> drainTx
+//   injectRx -> rxLine -> [RX timer] -> rxBuffer -> readBuffer
+struct Direction {
+  SpscRing<uint8_t> line;
+  uint32_t timer = 0;
+  // Set by the timer before it goes idle; whoever flips it back wakes it
+  std::atomic<bool> idle{true};
+  // Scheduler thread only: frames are counted from startNs so that
+  // rounding never accumulates
+  uint64_t startNs = 0;
+  uint64_t frames = 0;
+};
+
+// Claim of one line direction by a background source (see UART::claimRx).
+// The claimant arms the claim when it runs out of room or data; whoever
+// next makes progress possible disarms it and notifies.
+struct Claim {
+  std::atomic<bool> held{false};
+  std::atomic<bool> armed{false};
+  std::atomic<UART::LineNotify> notify{nullptr};
+  std::atomic<void *> context{nullptr};
+
+  bool acquire(UART::LineNotify callback, void *data) {
+    if (held.exchange(true, std::memory_order_acquire))
+      return false;
+    armed.store(false, std::memory_order_relaxed);
+    notify.store(callback, std::memory_order_relaxed);
+    context.store(data, std::memory_order_release);
+    return true;
+  }
+
+  void release() {
+    notify.store(nullptr, std::memory_order_relaxed);
+    held.store(false, std::memory_order_release);
+  }
+
+  // Claimant side, before checking the ring once more. Pairs with signal.
+  void arm() {
+    armed.store(true, std::memory_order_relaxed);
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+  }
+
+  // Must follow the ring update that made progress possible
+  void signal() {
+    // Orders the caller's ring update before reading the flag
+    std::atomic_thread_fence(std::memory_order_seq_cst);
+    if (armed.load(std::memory_order_relaxed) && armed.exchange(false)) {
+      UART::LineNotify callback = notify.load(std::memory_order_acquire);
+      if (callback)
+        callback(context.load(std::memory_order_acquire));
+    }
+  }
+};
+
+// Optional decoder fed with the bytes of one direction. The lock is only
+// taken while a decoder is attached, and is held while decoder callbacks
+// run. Bytes moved by the timers are queued instead and decoded on the
+// delivery thread, since decoder callbacks must not run with the scheduler
+// locked.
+struct Tap {
+  std::atomic<bool> attached{false};
   std::mutex mutex;
+  std::shared_ptr<FrameDecoder> decoder;
+  std::mutex queueMutex; // never held while decoding
+  std::vector<uint8_t> queued;
+  std::vector<uint8_t> decoding; // requires mutex
+
+  void feed(const uint8_t *data, size_t length) {
+    if (length == 0 || !attached.load(std::memory_order_acquire))
+      return;
+    std::lock_guard<std::mutex> lock(mutex);
+    flush(); // bytes queued earlier come first
+    if (decoder)
+      decoder->feed(data, length);
+  }
+
+  // Queue bytes for the delivery thread. Returns true if the queue was
+  // empty, in which case the caller posts the tap.
+  bool defer(const uint8_t *data, size_t length) {
+    if (length == 0 || !attached.load(std::memory_order_acquire))
+      return false;
+    std::lock_guard<std::mutex> lock(queueMutex);
+    bool wasEmpty = queued.empty();
+    queued.insert(queued.end(), data, data + length);
+    return wasEmpty;
+  }
+
+  // Decode the queued bytes. Requires mutex.
+  void flush() {
+    {
+      std::lock_guard<std::mutex> lock(queueMutex);
+      if (queued.empty())
+        return;
+      decoding.swap(queued);
+    }
+    if (decoder)
+      decoder->feed(decoding.data(), decoding.size());
+    decoding.clear();
+  }
+
+  // Drop queued bytes, e.g. when the decoder changes. Requires mutex.
+  void discard() {
+    std::lock_guard<std::mutex> lock(queueMutex);
+    queued.clear();
+  }
+};
+
+// Decodes the queued bytes of paced channels on one thread shared by all
+// channels, outside the scheduler lock
+class TapDelivery {
+public:
+  static TapDelivery &getInstance() {
+    static TapDelivery instance;
+    return instance;
+  }
+
+  void post(Tap *tap) {
+    std::lock_guard<std::mutex> lock(mutex_);
+    if (!thread_.joinable())
+      thread_ = std::thread(&TapDelivery::run, this);
+    queue_.push_back(tap);
+    cv_.notify_all();
+  }
+
+  // Forget a tap and wait for its decoding to finish, unless called from
+  // a decoder callback
+  void cancel(Tap *tap) {
+    std::unique_lock<std::mutex> lock(mutex_);
+    queue_.erase(std::remove(queue_.begin(), queue_.end(), tap),
+                 queue_.end());
+    if (std::this_thread::get_id() != thread_.get_id())
+      cv_.wait(lock, [&] { return current_ != tap; });
+  }
+
+private:
+  TapDelivery() = default;
+  ~TapDelivery() {
+    {
+      std::lock_guard<std::mutex> lock(mutex_);
+      stopping_ = true;
+      cv_.notify_all();
+    }
+    if (thread_.joinable())
+      thread_.join();
+  }
+
+  void run() {
+    std::unique_lock<std::mutex> lock(mutex_);
+    while (true) {
+      cv_.wait(lock, [&] { return stopping_ || !queue_.empty(); });
+      if (stopping_)
+        return;
+      Tap *tap = queue_.front();
+      queue_.pop_front();
+      current_ = tap;
+      lock.unlock();
+
+      {
+        std::lock_guard<std::mutex> tapLock(tap->mutex);
+        tap->flush();
+      }
+
+      lock.lock();
+      current_ = nullptr;
+      cv_.notify_all();
+    }
+  }
+
+  std::mutex mutex_;
+  std::condition_variable cv_;
+  std::deque<Tap *> queue_;
+  Tap *current_ = nullptr; // tap being decoded
+  bool stopping_ = false;
+  std::thread thread_;
 };
 
-UARTState uart_state;
+// Feed the RX decoder from a timer or a timing change
+void deferRx(Tap &tap, const uint8_t *data, size_t length) {
+  if (tap.defer(data, length))
+    TapDelivery::getInstance().post(&tap);
+}
+
+struct alignas(64) ChannelState {
+  uint8_t index = 0;
+  std::atomic<bool> initialized{false};
+  uint32_t baudRate = 0;
+  SpscRing<uint8_t> rxBuffer;
+  SpscRing<uint8_t> txBuffer;
+  std::atomic<uint64_t> rxOverflows{0};
+  std::atomic<uint64_t> txOverflows{0};
+  Claim rxClaim;
+  Claim txClaim;
+  std::mutex mutex;
+
+  // Timing model
+  std::atomic<bool> timed{false};
+  // Held by injectRx and by timing changes, so that the RX buffer never
+  // has the line side and the RX timer (or stopTiming) as producers at once
+  std::mutex injectMutex;
+  UARTFrameFormat format;
+  double frameNs = 0;
+  std::atomic<bool> cts{true};
+  Direction tx;
+  Direction rx;
+
+  Tap txTap;
+  Tap rxTap;
+};
+
+const UARTConfig kDefaultConfig{
+    4, // numChannels
+    {9600, 19200, 38400, 57600, 115200, 230400, 460800,
+     921600},  // supportedBaudRates
+    false,     // hasFlowControl
+    64 * 1024, // txBufferSize
+    64 * 1024  // rxBufferSize
+};
+
+// Bytes moved per copy when a timer catches up on several frames
+constexpr size_t kChunkSize = 256;
+
+// Fast channels move several frames per tick instead of waking the
+// scheduler for every byte
+constexpr uint64_t kMinTickNs = 50000;
+
+std::unique_ptr<ChannelState[]> makeChannels(uint8_t count) {
+  auto channels = std::make_unique<ChannelState[]>(count);
+  for (uint8_t i = 0; i < count; ++i)
+    channels[i].index = i;
+  return channels;
+}
+
+UARTConfig uart_config = kDefaultConfig;
+std::unique_ptr<ChannelState[]> channels =
+    makeChannels(kDefaultConfig.numChannels);
+
+ChannelState *findChannel(uint8_t channel) {
+  if (channel >= uart_config.numChannels)
+    return nullptr;
+  return &channels[channel];
+}
+
+// Returns the channel if it exists and has been initialized
+ChannelState *activeChannel(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  if (!state || !state->initialized.load(std::memory_order_acquire))
+    return nullptr;
+  return state;
+}
+
+bool supportedBaudRate(uint32_t baudRate) {
+  const auto &rates = uart_config.supportedBaudRates;
+  return baudRate > 0 &&
+         (rates.empty() ||
+          std::find(rates.begin(), rates.end(), baudRate) != rates.end());
+}
+
+// Deadline of the next frame, batching frames that end less than
+// kMinTickNs after this tick into one callback
+uint64_t nextTickNs(const ChannelState &state, const Direction &dir,
+                    uint64_t now) {
+  uint64_t next =
+      dir.startNs + static_cast<uint64_t>((dir.frames + 1) * state.frameNs);
+  return std::max(next, now + kMinTickNs);
+}
+
+// Frames that have completed since the last tick. A timer coming back from
+// idle starts counting at the deadline it was woken for.
+uint64_t dueFrames(const ChannelState &state, Direction &dir,
+                   uint64_t deadlineNs, uint64_t now) {
+  if (dir.startNs == 0) {
+    dir.startNs = deadlineNs - static_cast<uint64_t>(state.frameNs);
+    dir.frames = 0;
+  }
+  return static_cast<uint64_t>((now - dir.startNs) / state.frameNs) -
+         dir.frames;
+}
+
+// Let a timer go idle unless it can make progress again by now, in which
+// case it restarts one frame later. Pairs with wakeIdle.
+uint64_t goIdle(ChannelState &state, Direction &dir, uint64_t now,
+                bool (*canProgress)(ChannelState &)) {
+  dir.startNs = 0;
+  dir.idle.store(true);
+  if (!canProgress(state) || !dir.idle.exchange(false))
+    return 0;
+  return now + static_cast<uint64_t>(state.frameNs);
+}
+
+void wakeIdle(const ChannelState &state, Direction &dir) {
+  // Orders the caller's ring update before reading the flag
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (dir.idle.load(std::memory_order_relaxed) && dir.idle.exchange(false))
+    TimerScheduler::wake(dir.timer, TimerScheduler::nowNs() +
+                                        static_cast<uint64_t>(state.frameNs));
+}
+
+// TX shifts bytes out while there are any, CTS is asserted (with flow
+// control) and the line has room
+bool canTransmit(ChannelState &state) {
+  return !state.txBuffer.empty() &&
+         (!uart_config.hasFlowControl || state.cts.load()) &&
+         state.tx.line.size() < state.tx.line.capacity();
+}
+
+// RX delivers bytes while the line has any and, with flow control, the RX
+// buffer has room (RTS asserted)
+bool canReceive(ChannelState &state) {
+  return !state.rx.line.empty() &&
+         (!uart_config.hasFlowControl ||
+          state.rxBuffer.size() < state.rxBuffer.capacity());
+}
+
+uint64_t txTick(void *context, uint64_t deadlineNs, uint64_t now) {
+  auto &state = *static_cast<ChannelState *>(context);
+  Direction &tx = state.tx;
+  if (!canTransmit(state))
+    return goIdle(state, tx, now, canTransmit);
+
+  uint64_t due = dueFrames(state, tx, deadlineNs, now);
+  uint8_t chunk[kChunkSize];
+  uint64_t moved = 0;
+  while (moved < due) {
+    size_t space = tx.line.capacity() - tx.line.size();
+    size_t count = static_cast<size_t>(
+        std::min<uint64_t>({due - moved, space, sizeof(chunk)}));
+    count = state.txBuffer.pop(chunk, count);
+    if (count == 0)
+      break;
+    tx.line.push(chunk, count);
+    moved += count;
+  }
+  tx.frames += moved;
+  if (moved > 0)
+    state.txClaim.signal();
+
+  if (moved > 0 && state.txBuffer.empty())
+    InterruptManager::getInstance().triggerInterrupt(InterruptType::UART_TX,
+                                                     state.index);
+  if (moved < due)
+    return goIdle(state, tx, now, canTransmit);
+  return nextTickNs(state, tx, now);
+}
+
+uint64_t rxTick(void *context, uint64_t deadlineNs, uint64_t now) {
+  auto &state = *static_cast<ChannelState *>(context);
+  Direction &rx = state.rx;
+  if (!canReceive(state))
+    return goIdle(state, rx, now, canReceive);
+
+  uint64_t due = dueFrames(state, rx, deadlineNs, now);
+  uint8_t chunk[kChunkSize];
+  uint64_t moved = 0;
+  uint64_t received = 0;
+  while (moved < due) {
+    size_t count =
+        static_cast<size_t>(std::min<uint64_t>(due - moved, sizeof(chunk)));
+    if (uart_config.hasFlowControl)
+      count = std::min(count, state.rxBuffer.capacity() -
+                                  state.rxBuffer.size());
+    count = rx.line.pop(chunk, count);
+    if (count == 0)
+      break;
+    size_t stored = state.rxBuffer.push(chunk, count);
+    if (stored < count)
+      state.rxOverflows.fetch_add(count - stored, std::memory_order_relaxed);
+    deferRx(state.rxTap, chunk, stored);
+    moved += count;
+    received += stored;
+  }
+  rx.frames += moved;
+  if (moved > 0)
+    state.rxClaim.signal(); // the line has room again
+
+  if (received > 0)
+    InterruptManager::getInstance().triggerInterrupt(InterruptType::UART_RX,
+                                                     state.index);
+  if (moved < due)
+    return goIdle(state, rx, now, canReceive);
+  return nextTickNs(state, rx, now);
+}
+
+// Start pacing a channel with its current format and baud rate. Requires
+// the channel's mutex.
+void startTiming(ChannelState &state) {
+  std::lock_guard<std::mutex> inject(state.injectMutex);
+  const auto &format = state.format;
+  unsigned bits = 1 + format.dataBits +
+                  (format.parity != UARTParity::NONE ? 1 : 0) +
+                  format.stopBits;
+  state.frameNs = bits * 1e9 / state.baudRate;
+  state.cts = true;
+
+  for (Direction *dir : {&state.tx, &state.rx}) {
+    dir->line.reset(dir == &state.tx ? uart_config.txBufferSize
+                                     : uart_config.rxBufferSize);
+    dir->startNs = 0;
+    dir->idle = true;
+  }
+  state.tx.timer = TimerScheduler::add(txTick, &state);
+  state.rx.timer = TimerScheduler::add(rxTick, &state);
+  state.timed.store(true, std::memory_order_release);
+
+  wakeIdle(state, state.tx); // bytes already queued start shifting out
+  state.rxClaim.signal();    // injection now goes to the empty RX line
+}
+
+// Stop pacing a channel, delivering bytes still on the RX line. Bytes on the
+// TX line stay there for drainTx. Requires the channel's mutex.
+void stopTiming(ChannelState &state) {
+  if (!state.timed.load())
+    return;
+
+  std::lock_guard<std::mutex> inject(state.injectMutex);
+  state.timed.store(false, std::memory_order_release);
+  TimerScheduler::remove(state.tx.timer);
+  TimerScheduler::remove(state.rx.timer);
+
+  uint8_t chunk[kChunkSize];
+  while (size_t count = state.rx.line.pop(chunk, sizeof(chunk))) {
+    size_t stored = state.rxBuffer.push(chunk, count);
+    if (stored < count)
+      state.rxOverflows.fetch_add(count - stored, std::memory_order_relaxed);
+    deferRx(state.rxTap, chunk, stored);
+  }
+  // drainTx and rxSpace now look at the buffers directly
+  state.txClaim.signal();
+  state.rxClaim.signal();
+}
 } // namespace
 
-bool UART::initialize(uint32_t baudRate) {
-  std::lock_guard<std::mutex> lock(uart_state.mutex);
-  uart_state.initialized = true;
-  uart_state.baudRate = baudRate;
+void UART::configure(const UARTConfig &config) {
+  for (uint8_t i = 0; i < uart_config.numChannels; ++i) {
+    std::lock_guard<std::mutex> lock(channels[i].mutex);
+    stopTiming(channels[i]);
+    TapDelivery::getInstance().cancel(&channels[i].rxTap);
+  }
+  channels = makeChannels(config.numChannels);
+  uart_config = config;
+}
+
+const UARTConfig &UART::getConfig() { return uart_config; }
+
+bool UART::initialize(uint32_t baudRate) { return initialize(0, baudRate); }
+
+bool UART::initialize(uint8_t channel, uint32_t baudRate) {
+  ChannelState *state = findChannel(channel);
+  if (!state || !supportedBaudRate(baudRate))
+    return false;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  bool timed = state->timed.load();
+  stopTiming(*state);
+  state->initialized = false;
+  state->baudRate = baudRate;
+  state->rxBuffer.reset(uart_config.rxBufferSize);
+  state->txBuffer.reset(uart_config.txBufferSize);
+  state->tx.line.reset(0);
+  state->rxOverflows = 0;
+  state->txOverflows = 0;
+  if (timed)
+    startTiming(*state);
+  state->initialized = true;
   return true;
 }
 
-bool UART::write(uint8_t data) {
-  if (!uart_state.initialized)
+bool UART::write(uint8_t data) { return write(0, data); }
+
+bool UART::write(uint8_t channel, uint8_t data) {
+  return writeBuffer(channel, &data, 1) == 1;
+}
+
+size_t UART::writeBuffer(const uint8_t *data, size_t length) {
+  return writeBuffer(0, data, length);
+}
+
+size_t UART::writeBuffer(uint8_t channel, const uint8_t *data,
+                         size_t length) {
+  ChannelState *state = activeChannel(channel);
+  if (!state)
+    return 0;
+
+  size_t written = state->txBuffer.push(data, length);
+  if (written < length)
+    state->txOverflows.fetch_add(length - written, std::memory_order_relaxed);
+  state->txTap.feed(data, written);
+  if (written > 0) {
+    if (state->timed.load(std::memory_order_acquire))
+      wakeIdle(*state, state->tx);
+    else
+      state->txClaim.signal();
+  }
+  return written;
+}
+
+bool UART::read(uint8_t &data) { return read(0, data); }
+
+bool UART::read(uint8_t channel, uint8_t &data) {
+  return readBuffer(channel, &data, 1) == 1;
+}
+
+size_t UART::readBuffer(uint8_t *data, size_t length) {
+  return readBuffer(0, data, length);
+}
+
+size_t UART::readBuffer(uint8_t channel, uint8_t *data, size_t length) {
+  ChannelState *state = activeChannel(channel);
+  if (!state)
+    return 0;
+
+  size_t count = state->rxBuffer.pop(data, length);
+  if (count > 0) {
+    if (!state->timed.load(std::memory_order_acquire))
+      state->rxClaim.signal();
+    else if (uart_config.hasFlowControl && !state->rx.line.empty())
+      wakeIdle(*state, state->rx); // RTS reasserted
+  }
+  return count;
+}
+
+bool UART::available() { return available(0); }
+
+bool UART::available(uint8_t channel) {
+  ChannelState *state = activeChannel(channel);
+  return state && !state->rxBuffer.empty();
+}
+
+size_t UART::injectRx(const uint8_t *data, size_t length) {
+  return injectRx(0, data, length);
+}
+
+size_t UART::injectRx(uint8_t channel, const uint8_t *data, size_t length) {
+  ChannelState *state = activeChannel(channel);
+  if (!state)
+    return 0;
+
+  std::lock_guard<std::mutex> inject(state->injectMutex);
+  bool timed = state->timed.load(std::memory_order_acquire);
+  size_t received = timed ? state->rx.line.push(data, length)
+                          : state->rxBuffer.push(data, length);
+  if (received < length)
+    state->rxOverflows.fetch_add(length - received, std::memory_order_relaxed);
+  if (!timed)
+    state->rxTap.feed(data, received);
+  else if (received > 0)
+    wakeIdle(*state, state->rx);
+  return received;
+}
+
+bool UART::claimRx(uint8_t channel, LineNotify notify, void *context) {
+  ChannelState *state = findChannel(channel);
+  return state && state->rxClaim.acquire(notify, context);
+}
+
+void UART::releaseRx(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  if (state)
+    state->rxClaim.release();
+}
+
+bool UART::claimTx(uint8_t channel, LineNotify notify, void *context) {
+  ChannelState *state = findChannel(channel);
+  return state && state->txClaim.acquire(notify, context);
+}
+
+void UART::releaseTx(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  if (state)
+    state->txClaim.release();
+}
+
+size_t UART::rxSpace(uint8_t channel) {
+  ChannelState *state = activeChannel(channel);
+  if (!state)
+    return 0;
+
+  const auto &ring = state->timed.load(std::memory_order_acquire)
+                         ? state->rx.line
+                         : state->rxBuffer;
+  size_t space = ring.capacity() - ring.size();
+  if (space == 0) {
+    state->rxClaim.arm();
+    space = ring.capacity() - ring.size(); // room made while arming
+  }
+  return space;
+}
+
+size_t UART::drainTx(uint8_t *data, size_t length) {
+  return drainTx(0, data, length);
+}
+
+size_t UART::drainTx(uint8_t channel, uint8_t *data, size_t length) {
+  ChannelState *state = activeChannel(channel);
+  if (!state)
+    return 0;
+
+  bool timed = state->timed.load(std::memory_order_acquire);
+  size_t count = state->tx.line.pop(data, length);
+  if (timed && count > 0 && !state->txBuffer.empty())
+    wakeIdle(*state, state->tx); // the line has room again
+  if (!timed && count < length)
+    count += state->txBuffer.pop(data + count, length - count);
+  if (count < length) {
+    // Drained dry: ask to be notified of more, then take what was queued
+    // while arming
+    state->txClaim.arm();
+    count += state->tx.line.pop(data + count, length - count);
+    if (!timed && count < length)
+      count += state->txBuffer.pop(data + count, length - count);
+  }
+  return count;
+}
+
+bool UART::enableTiming(uint8_t channel, const UARTFrameFormat &format) {
+  ChannelState *state = activeChannel(channel);
+  if (!state || format.dataBits < 5 || format.dataBits > 8 ||
+      format.stopBits < 1 || format.stopBits > 2)
     return false;
 
-  std::lock_guard<std::mutex> lock(uart_state.mutex);
-  uart_state.txBuffer.push(data);
+  std::lock_guard<std::mutex> lock(state->mutex);
+  stopTiming(*state);
+  state->format = format;
+  startTiming(*state);
   return true;
 }
 
-bool UART::read(uint8_t &data) {
-  if (!uart_state.initialized)
+void UART::disableTiming(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  if (!state)
+    return;
+
+  std::lock_guard<std::mutex> lock(state->mutex);
+  stopTiming(*state);
+}
+
+bool UART::isTimingEnabled(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  return state && state->timed.load();
+}
+
+bool UART::setCts(uint8_t channel, bool clearToSend) {
+  ChannelState *state = activeChannel(channel);
+  if (!state || !uart_config.hasFlowControl)
     return false;
 
-  std::lock_guard<std::mutex> lock(uart_state.mutex);
-  if (uart_state.rxBuffer.empty())
+  state->cts = clearToSend;
+  if (clearToSend && state->timed.load(std::memory_order_acquire) &&
+      !state->txBuffer.empty())
+    wakeIdle(*state, state->tx);
+  return true;
+}
+
+bool UART::setDecoder(uint8_t channel, UARTDirection direction,
+                      std::shared_ptr<FrameDecoder> decoder) {
+  ChannelState *state = findChannel(channel);
+  if (!state)
     return false;
 
-  data = uart_state.rxBuffer.front();
-  uart_state.rxBuffer.pop();
+  Tap &tap = direction == UARTDirection::TX ? state->txTap : state->rxTap;
+  std::lock_guard<std::mutex> lock(tap.mutex);
+  tap.discard(); // bytes queued for the old decoder
+  tap.decoder = std::move(decoder);
+  tap.attached.store(tap.decoder != nullptr, std::memory_order_release);
   return true;
 }
 
-bool UART::available() {
-  std::lock_guard<std::mutex> lock(uart_state.mutex);
-  return !uart_state.rxBuffer.empty();
+UART::Stats UART::getStats() { return getStats(0); }
+
+UART::Stats UART::getStats(uint8_t channel) {
+  ChannelState *state = findChannel(channel);
+  if (!state)
+    return Stats{};
+
+  return Stats{state->txBuffer.size(), state->rxBuffer.size(),
+               state->txOverflows.load(std::memory_order_relaxed),
+               state->rxOverflows.load(std::memory_order_relaxed)};
 }
 
-std::string UART::saveState() {
-  std::lock_guard<std::mutex> lock(uart_state.mutex);
+std::string UART::saveState() { return saveState(0); }
+
+std::string UART::saveState(uint8_t channel) {
+  ChannelState *channelState = findChannel(channel);
+  if (!channelState)
+    return std::string();
+
+  // The mutex only orders against initialization and timing changes;
+  // peeking the rings relies on the caller keeping consumers away
+  std::lock_guard<std::mutex> lock(channelState->mutex);
 
   json state;
-  state["initialized"] = uart_state.initialized;
-  state["baudRate"] = uart_state.baudRate;
+  state["initialized"] = channelState->initialized.load();
+  state["baudRate"] = channelState->baudRate;
 
   // Save RX buffer
-  std::vector<uint8_t> rxData;
-  auto rxTemp = uart_state.rxBuffer;
-  while (!rxTemp.empty()) {
-    rxData.push_back(rxTemp.front());
-    rxTemp.pop();
-  }
+  std::vector<uint8_t> rxData(channelState->rxBuffer.size());
+  rxData.resize(channelState->rxBuffer.peek(rxData.data(), rxData.size()));
   state["rxBuffer"] = rxData;
 
   // Save TX buffer
-  std::vector<uint8_t> txData;
-  auto txTemp = uart_state.txBuffer;
-  while (!txTemp.empty()) {
-    txData.push_back(txTemp.front());
-    txTemp.pop();
-  }
+  std::vector<uint8_t> txData(channelState->txBuffer.size());
+  txData.resize(channelState->txBuffer.peek(txData.data(), txData.size()));
   state["txBuffer"] = txData;
 
   return state.dump();
 }
 
-bool UART::restoreState(const std::string &state_str) {
+bool UART::restoreState(const std::string &state) {
+  return restoreState(0, state);
+}
+
+bool UART::restoreState(uint8_t channel, const std::string &state_str) {
+  ChannelState *channelState = findChannel(channel);
+  if (!channelState)
+    return false;
+
   try {
     auto state = json::parse(state_str);
+    auto rxData = state["rxBuffer"].get<std::vector<uint8_t>>();
+    auto txData = state["txBuffer"].get<std::vector<uint8_t>>();
 
-    std::lock_guard<std::mutex> lock(uart_state.mutex);
+    std::lock_guard<std::mutex> lock(channelState->mutex);
 
-    uart_state.initialized = state["initialized"];
-    uart_state.baudRate = state["baudRate"];
+    channelState->initialized = state["initialized"].get<bool>();
+    channelState->baudRate = state["baudRate"];
 
     // Clear and restore RX buffer
-    while (!uart_state.rxBuffer.empty())
-      uart_state.rxBuffer.pop();
-    for (const auto &byte : state["rxBuffer"]) {
-      uart_state.rxBuffer.push(byte);
-    }
+    channelState->rxBuffer.reset(uart_config.rxBufferSize);
+    channelState->rxBuffer.push(rxData.data(), rxData.size());
 
     // Clear and restore TX buffer
-    while (!uart_state.txBuffer.empty())
-      uart_state.txBuffer.pop();
-    for (const auto &byte : state["txBuffer"]) {
-      uart_state.txBuffer.push(byte);
-    }
+    channelState->txBuffer.reset(uart_config.txBufferSize);
+    channelState->txBuffer.push(txData.data(), txData.size());
 
     return true;
   } catch (const std::exception &) {
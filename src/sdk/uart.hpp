@@ -1,29 +1,158 @@
 #pragma once
 
+#include "device_profile.hpp"
+#include <cstddef>
 #include <cstdint>
+#include <memory>
 #include <string>
 
 namespace ti_sdk {
 
+class FrameDecoder;
+
+enum class UARTParity { NONE, EVEN, ODD };
+
+enum class UARTDirection { TX, RX };
+
+// Character frame on the wire; a frame also carries one start bit
+struct UARTFrameFormat {
+  uint8_t dataBits = 8; // 5 to 8
+  UARTParity parity = UARTParity::NONE;
+  uint8_t stopBits = 1; // 1 or 2
+};
+
+// Emulated UART channels. Every channel has its own buffers and no state is
+// shared between channels, so channels can be driven from different
+// threads. The overloads without a channel argument operate on channel 0.
 class UART {
 public:
+  struct Stats {
+    size_t txPending;     // bytes waiting in the TX buffer
+    size_t rxPending;     // bytes waiting in the RX buffer
+    uint64_t txOverflows; // bytes rejected because the TX buffer was full
+    uint64_t rxOverflows; // bytes lost because the RX buffer was full
+  };
+
+  // Set the channel count, buffer sizes and supported baud rates from a
+  // device profile. Deinitializes all channels; must not run concurrently
+  // with other UART calls.
+  static void configure(const UARTConfig &config);
+
+  // Get the active configuration
+  static const UARTConfig &getConfig();
+
   // Initialize UART with specified baud rate
   static bool initialize(uint32_t baudRate);
+  static bool initialize(uint8_t channel, uint32_t baudRate);
 
   // Write a byte to UART
   static bool write(uint8_t data);
+  static bool write(uint8_t channel, uint8_t data);
+
+  // Write a buffer to UART, returns the number of bytes accepted
+  static size_t writeBuffer(const uint8_t *data, size_t length);
+  static size_t writeBuffer(uint8_t channel, const uint8_t *data,
+                            size_t length);
 
   // Read a byte from UART
   static bool read(uint8_t &data);
+  static bool read(uint8_t channel, uint8_t &data);
+
+  // Read up to length bytes from UART, returns the number of bytes read
+  static size_t readBuffer(uint8_t *data, size_t length);
+  static size_t readBuffer(uint8_t channel, uint8_t *data, size_t length);
 
   // Check if data is available to read
   static bool available();
+  static bool available(uint8_t channel);
+
+  // Line side of the emulated UART: deliver bytes into the RX buffer as if
+  // received, returns the number of bytes that fit (the rest are counted
+  // as RX overflows). A channel's receiver has a single producer: while a
+  // background source (UARTReplay, UARTPtyBridge) holds it through claimRx,
+  // nothing else may inject into that channel.
+  static size_t injectRx(const uint8_t *data, size_t length);
+  static size_t injectRx(uint8_t channel, const uint8_t *data, size_t length);
+
+  // Called when a claimed direction of a line can make progress again.
+  // Runs on whichever thread made room or queued data, possibly with the
+  // TimerScheduler locked, so it must only signal the claimant.
+  using LineNotify = void (*)(void *context);
+
+  // Line side of the emulated UART: reserve a channel's receiver for one
+  // background source. Returns false if another source already holds it.
+  // notify, if set, is called once rxSpace has returned 0 and room frees up.
+  static bool claimRx(uint8_t channel, LineNotify notify = nullptr,
+                      void *context = nullptr);
+
+  // Give back a receiver reserved with claimRx
+  static void releaseRx(uint8_t channel);
+
+  // Line side of the emulated UART: reserve drainTx of a channel for one
+  // consumer, since the TX buffer has a single consumer. Returns false if
+  // another consumer already holds it. notify, if set, is called once
+  // drainTx has returned less than asked and more bytes can be drained.
+  static bool claimTx(uint8_t channel, LineNotify notify = nullptr,
+                      void *context = nullptr);
+
+  // Give back drainTx reserved with claimTx
+  static void releaseTx(uint8_t channel);
+
+  // Line side of the emulated UART: number of bytes injectRx would accept
+  // right now without counting overflows
+  static size_t rxSpace(uint8_t channel);
+
+  // Line side of the emulated UART: take up to length transmitted bytes out
+  // of the TX buffer. Only the holder of claimTx may call this while the
+  // channel is claimed.
+  static size_t drainTx(uint8_t *data, size_t length);
+  static size_t drainTx(uint8_t channel, uint8_t *data, size_t length);
+
+  // Pace the channel at its baud rate: transmitted bytes reach drainTx and
+  // injected bytes reach the RX buffer one frame time apart instead of
+  // instantly. UART_TX is raised when the TX buffer has been shifted out
+  // and UART_RX when received bytes land in the RX buffer. All paced
+  // channels share one scheduler thread.
+  static bool enableTiming(uint8_t channel,
+                           const UARTFrameFormat &format = {});
+
+  // Return to instant delivery, flushing bytes still on the line
+  static void disableTiming(uint8_t channel);
+
+  // Check if a channel is paced at its baud rate
+  static bool isTimingEnabled(uint8_t channel);
+
+  // Line side of the hardware flow control (UARTConfig::hasFlowControl):
+  // while CTS is deasserted a paced channel stops transmitting. With flow
+  // control, received bytes wait on the line (RTS deasserted) while the RX
+  // buffer is full instead of being lost.
+  static bool setCts(uint8_t channel, bool clearToSend);
+
+  // Attach a frame decoder to one direction of a channel, or detach it with
+  // nullptr. TX decodes the bytes accepted by writeBuffer and RX the bytes
+  // stored in the RX buffer, on the thread producing them; on a paced
+  // channel RX is decoded on a separate delivery thread instead, never on
+  // the timer thread, so callbacks may reply with writeBuffer. Decoder
+  // callbacks must not attach or detach decoders, nor feed the direction
+  // they decode (e.g. loop RX back with injectRx).
+  static bool setDecoder(uint8_t channel, UARTDirection direction,
+                         std::shared_ptr<FrameDecoder> decoder);
+
+  // Get buffer statistics
+  static Stats getStats();
+  static Stats getStats(uint8_t channel);
 
-  // Save current UART state to JSON
+  // Save current UART state to JSON. The buffers are copied without the
+  // consumer's cooperation, so the channel must be quiescent: no read,
+  // readBuffer or drainTx may run concurrently, nor may its timers (disable
+  // timing first).
   static std::string saveState();
+  static std::string saveState(uint8_t channel);
 
-  // Restore UART state from JSON
+  // Restore UART state from JSON. Resets the buffers, so like saveState it
+  // requires a quiescent channel.
   static bool restoreState(const std::string &state);
+  static bool restoreState(uint8_t channel, const std::string &state);
 
 private:
   UART() = delete; // Prevent instantiation
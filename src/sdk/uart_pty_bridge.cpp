@@ -0,0 +1,323 @@
+#include "uart_pty_bridge.hpp"
+#include "logger.hpp"
+#include "uart.hpp"
+#include <algorithm>
+#include <array>
+#include <cerrno>
+#include <cstdlib>
+#include <fcntl.h>
+#include <memory>
+#include <mutex>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <termios.h>
+#include <thread>
+#include <unistd.h>
+
+
+namespace ti_sdk {
+
+namespace {
+// Largest single read from or write to a terminal
+constexpr size_t kChunkSize = 64 * 1024;
+
+constexpr int kMaxEvents = 64;
+
+// epoll tag of the eventfd that interrupts epoll_wait
+constexpr uint32_t kWakeTag = 0xFFFFFFFF;
+
+
+// Bytes read or drained but not yet delivered to the other side
+struct Pending {
+  std::unique_ptr<uint8_t[]> data{new uint8_t[kChunkSize]};
+  size_t begin = 0;
+  size_t end = 0;
+
+  bool empty() const { return begin == end; }
+  size_t size() const { return end - begin; }
+};
+
+struct Port {
+  int master = -1;
+  int slave = -1; // held open so the master never reports a hangup
+  std::string path;
+  uint32_t events = 0; // current epoll interest
+  bool readable = false;
+  Pending in;  // terminal -> RX
+  Pending out; // TX -> terminal
+  UARTPtyBridge::Stats stats{};
+};
+
+class Bridge {
+public:
+  static Bridge &getInstance() {
+    static Bridge instance;
+    return instance;
+  }
+
+  std::mutex mutex;
+  std::array<std::unique_ptr<Port>, 256> ports;
+
+  // Requires mutex
+  bool open(uint8_t channel, std::string &path) {
+    if (ports[channel] || channel >= UART::getConfig().numChannels)
+      return false;
+    if (!start() || !claim(channel))
+      return false;
+
+    auto port = std::make_unique<Port>();
+    port->master = posix_openpt(O_RDWR | O_NOCTTY | O_NONBLOCK | O_CLOEXEC);
+    char name[128];
+    if (port->master < 0 || grantpt(port->master) != 0 ||
+        unlockpt(port->master) != 0 ||
+        ptsname_r(port->master, name, sizeof(name)) != 0) {
+      closePort(*port);
+      unclaim(channel);
+      return false;
+    }
+    port->path = name;
+
+    // Raw mode: no echo, no line editing, no newline translation
+    port->slave = ::open(name, O_RDWR | O_NOCTTY | O_CLOEXEC);
+    termios tio{};
+    if (port->slave < 0 || tcgetattr(port->slave, &tio) != 0) {
+      closePort(*port);
+      unclaim(channel);
+      return false;
+    }
+    cfmakeraw(&tio);
+    tcsetattr(port->slave, TCSANOW, &tio);
+
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u32 = channel;
+    if (epoll_ctl(epoll_, EPOLL_CTL_ADD, port->master, &event) != 0) {
+      closePort(*port);
+      unclaim(channel);
+      return false;
+    }
+    port->events = EPOLLIN;
+
+    path = port->path;
+    ports[channel] = std::move(port);
+    wake(); // recompute the poll timeout
+    return true;
+  }
+
+  // Requires mutex
+  bool close(uint8_t channel) {
+    if (!ports[channel])
+      return false;
+
+    epoll_ctl(epoll_, EPOLL_CTL_DEL, ports[channel]->master, nullptr);
+    closePort(*ports[channel]);
+    ports[channel].reset();
+    unclaim(channel);
+    return true;
+  }
+
+  // Stop the I/O thread. Must not hold mutex.
+  void stop() {
+    {
+      std::lock_guard<std::mutex> lock(mutex);
+      running_ = false;
+    }
+    wake();
+    if (thread_.joinable()) {
+      thread_.join();
+    }
+  }
+
+private:
+  Bridge() {
+    epoll_ = epoll_create1(EPOLL_CLOEXEC);
+    wake_ = eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC);
+    epoll_event event{};
+    event.events = EPOLLIN;
+    event.data.u32 = kWakeTag;
+    epoll_ctl(epoll_, EPOLL_CTL_ADD, wake_, &event);
+  }
+
+  ~Bridge() {
+    stop();
+    for (size_t channel = 0; channel < ports.size(); ++channel)
+      close(static_cast<uint8_t>(channel));
+    ::close(wake_);
+    ::close(epoll_);
+  }
+
+  // Requires mutex
+  bool start() {
+    if (epoll_ < 0 || wake_ < 0)
+      return false;
+    if (!running_) {
+      running_ = true;
+      thread_ = std::thread(&Bridge::run, this);
+    }
+    return true;
+  }
+
+  void wake() {
+    uint64_t one = 1;
+    (void)!::write(wake_, &one, sizeof(one));
+  }
+
+  // Become the only RX producer and TX consumer of a channel, woken when
+  // the firmware makes room in RX or queues bytes for TX
+  bool claim(uint8_t channel) {
+    if (!UART::claimRx(channel, notify, this))
+      return false;
+    if (!UART::claimTx(channel, notify, this)) {
+      UART::releaseRx(channel);
+      return false;
+    }
+    return true;
+  }
+
+  static void unclaim(uint8_t channel) {
+    UART::releaseRx(channel);
+    UART::releaseTx(channel);
+  }
+
+  static void notify(void *context) { static_cast<Bridge *>(context)->wake(); }
+
+  static void closePort(Port &port) {
+    if (port.slave >= 0)
+      ::close(port.slave);
+    if (port.master >= 0)
+      ::close(port.master);
+    port.slave = -1;
+    port.master = -1;
+  }
+
+  void run() {
+    epoll_event events[kMaxEvents];
+    int timeoutMs = -1;
+    while (true) {
+      int count = epoll_wait(epoll_, events, kMaxEvents, timeoutMs);
+
+      std::lock_guard<std::mutex> lock(mutex);
+      if (!running_)
+        break;
+
+      for (int i = 0; i < count; ++i) {
+        uint32_t tag = events[i].data.u32;
+        if (tag == kWakeTag) {
+          uint64_t value;
+          (void)!::read(wake_, &value, sizeof(value));
+        } else if (ports[tag]) {
+          ports[tag]->readable = true;
+        }
+      }
+
+      // Pump until nothing moves. A stalled direction has then either
+      // registered with epoll or armed its UART notification.
+      bool moved = false;
+      for (size_t channel = 0; channel < ports.size(); ++channel) {
+        if (ports[channel])
+          moved |= pump(static_cast<uint8_t>(channel), *ports[channel]);
+      }
+      timeoutMs = moved ? 0 : -1;
+    }
+  }
+
+  // Move data both ways for one channel, returns true if anything moved
+  bool pump(uint8_t channel, Port &port) {
+    bool moved = false;
+
+    // Terminal -> RX, reading only once the previous chunk is delivered
+    if (port.in.empty() && port.readable) {
+      ssize_t n = ::read(port.master, port.in.data.get(), kChunkSize);
+      if (n > 0) {
+        port.in.begin = 0;
+        port.in.end = static_cast<size_t>(n);
+      }
+    }
+    port.readable = false;
+    if (!port.in.empty()) {
+      size_t n = std::min(port.in.size(), UART::rxSpace(channel));
+      n = UART::injectRx(channel, port.in.data.get() + port.in.begin, n);
+      port.in.begin += n;
+      port.stats.bytesIn += n;
+      moved |= n > 0;
+    }
+
+    // TX -> terminal, draining only once the previous chunk is written
+    if (port.out.empty()) {
+      port.out.begin = 0;
+      port.out.end = UART::drainTx(channel, port.out.data.get(), kChunkSize);
+    }
+    if (!port.out.empty()) {
+      ssize_t n = ::write(port.master, port.out.data.get() + port.out.begin,
+                          port.out.size());
+      if (n > 0) {
+        port.out.begin += static_cast<size_t>(n);
+        port.stats.bytesOut += static_cast<size_t>(n);
+        moved = true;
+      }
+    }
+
+    // Wait for terminal input only when there is room to take it, and for
+    // terminal space only when output is stuck
+    uint32_t wanted = 0;
+    if (port.in.empty())
+      wanted |= EPOLLIN;
+    if (!port.out.empty())
+      wanted |= EPOLLOUT;
+    if (wanted != port.events) {
+      epoll_event event{};
+      event.events = wanted;
+      event.data.u32 = channel;
+      epoll_ctl(epoll_, EPOLL_CTL_MOD, port.master, &event);
+      port.events = wanted;
+    }
+    return moved;
+  }
+
+  int epoll_ = -1;
+  int wake_ = -1;
+  std::thread thread_;
+  bool running_ = false;
+};
+} // namespace
+
+bool UARTPtyBridge::open(uint8_t channel, std::string &path) {
+  auto &bridge = Bridge::getInstance();
+  std::lock_guard<std::mutex> lock(bridge.mutex);
+  if (!bridge.open(channel, path)) {
+    LOG_ERROR("Failed to create pseudo-terminal for UART channel " +
+              std::to_string(channel));
+    return false;
+  }
+
+  LOG_INFO("UART channel " + std::to_string(channel) + " bridged to " + path);
+  return true;
+}
+
+bool UARTPtyBridge::close(uint8_t channel) {
+  auto &bridge = Bridge::getInstance();
+  std::lock_guard<std::mutex> lock(bridge.mutex);
+  return bridge.close(channel);
+}
+
+void UARTPtyBridge::closeAll() {
+  auto &bridge = Bridge::getInstance();
+  bridge.stop();
+  std::lock_guard<std::mutex> lock(bridge.mutex);
+  for (size_t channel = 0; channel < bridge.ports.size(); ++channel)
+    bridge.close(static_cast<uint8_t>(channel));
+}
+
+std::string UARTPtyBridge::getPath(uint8_t channel) {
+  auto &bridge = Bridge::getInstance();
+  std::lock_guard<std::mutex> lock(bridge.mutex);
+  return bridge.ports[channel] ? bridge.ports[channel]->path : std::string();
+}
+
+UARTPtyBridge::Stats UARTPtyBridge::getStats(uint8_t channel) {
+  auto &bridge = Bridge::getInstance();
+  std::lock_guard<std::mutex> lock(bridge.mutex);
+  return bridge.ports[channel] ? bridge.ports[channel]->stats : Stats{};
+}
+
+} // namespace ti_sdk
\ No newline at end of file
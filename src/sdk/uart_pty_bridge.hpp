@@ -0,0 +1,45 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ti_sdk {
+
+// Exposes UART channels as Linux pseudo-terminals so that host tools
+// (minicom, pyserial) can talk to the emulated firmware. Bytes written to
+// the terminal arrive through UART::injectRx and bytes the firmware
+// transmits are drained with UART::drainTx. A single epoll thread serves
+// all bridged channels with bulk reads and writes; when one side cannot
+// keep up the other side is throttled instead of dropping data. The thread
+// sleeps until a terminal is ready or the UART notifies it of queued TX
+// bytes or freed RX space, so idle bridges do not poll.
+class UARTPtyBridge {
+public:
+  struct Stats {
+    uint64_t bytesIn;  // bytes moved from the terminal into RX
+    uint64_t bytesOut; // bytes moved from TX to the terminal
+  };
+
+  // Create a pseudo-terminal for an initialized channel and return its
+  // slave device path (e.g. /dev/pts/3). The bridge becomes the only RX
+  // source and TX consumer of the channel, so this fails while UARTReplay
+  // feeds it (see UART::claimRx and UART::claimTx).
+  static bool open(uint8_t channel, std::string &path);
+
+  // Remove the pseudo-terminal of a channel
+  static bool close(uint8_t channel);
+
+  // Remove all pseudo-terminals and stop the I/O thread
+  static void closeAll();
+
+  // Get the slave device path of a bridged channel, empty if not bridged
+  static std::string getPath(uint8_t channel);
+
+  // Get transfer statistics of a bridged channel
+  static Stats getStats(uint8_t channel);
+
+private:
+  UARTPtyBridge() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
@@ -0,0 +1,206 @@
+#include "uart_replay.hpp"
+#include "mapped_file.hpp"
+#include "scheduler.hpp"
+#include "uart.hpp"
+#include <algorithm>
+#include <array>
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <memory>
+#include <mutex>
+#include <thread>
+
+
+namespace ti_sdk {
+
+namespace {
+// Bytes mapped per view of the capture
+constexpr size_t kChunkSize = 1024 * 1024;
+
+// Pause while the RX buffer is full
+constexpr auto kStallSleep = std::chrono::microseconds(50);
+
+class Replay {
+public:
+  ~Replay() { stop(); }
+
+  bool start(uint8_t channel, const std::string &filename, bool timed) {
+    if (running_.load())
+      return false;
+    if (thread_.joinable())
+      thread_.join();
+
+    if (!UART::claimRx(channel))
+      return false;
+    if (!file_.open(filename)) {
+      UART::releaseRx(channel);
+      return false;
+    }
+
+    channel_ = channel;
+    timed_ = timed;
+    bytes_ = 0;
+    records_ = 0;
+    stalls_ = 0;
+    stopRequested_ = false;
+    running_ = true;
+    thread_ = std::thread(&Replay::run, this);
+    return true;
+  }
+
+  bool stop() {
+    if (!thread_.joinable())
+      return false;
+
+    bool wasRunning = running_.load();
+    stopRequested_ = true;
+    thread_.join();
+    return wasRunning;
+  }
+
+  bool isRunning() const { return running_.load(); }
+
+  UARTReplay::Stats getStats() const {
+    return UARTReplay::Stats{bytes_.load(), records_.load(), stalls_.load()};
+  }
+
+private:
+  void run() {
+    size_t available;
+    const uint8_t *head = file_.view(0, sizeof(kUartCaptureMagic), available);
+    startNs_ = TimerScheduler::nowNs();
+    if (head && available >= sizeof(kUartCaptureMagic) &&
+        std::memcmp(head, kUartCaptureMagic, sizeof(kUartCaptureMagic)) ==
+            0) {
+      playRecords();
+    } else {
+      feed(0, file_.size());
+    }
+    file_.close();
+    UART::releaseRx(channel_);
+    running_ = false;
+  }
+
+  // Wait until a capture timestamp is due. Returns false if stopped.
+  bool waitFor(uint64_t timestampNs) {
+    if (!timed_)
+      return !stopRequested_;
+    return TimerScheduler::waitUntil(startNs_ + timestampNs, stopRequested_);
+  }
+
+  // Inject length bytes starting at offset, waiting for RX space as
+  // needed. Returns false if stopped or the file could not be mapped.
+  bool feed(uint64_t offset, uint64_t length) {
+    while (length > 0) {
+      size_t available;
+      const uint8_t *data = file_.view(
+          offset, static_cast<size_t>(std::min<uint64_t>(length, kChunkSize)),
+          available);
+      if (!data)
+        return false;
+      available = static_cast<size_t>(std::min<uint64_t>(available, length));
+
+      size_t done = 0;
+      while (done < available) {
+        if (stopRequested_)
+          return false;
+        size_t count = std::min(available - done, UART::rxSpace(channel_));
+        count = UART::injectRx(channel_, data + done, count);
+        if (count == 0) {
+          ++stalls_;
+          std::this_thread::sleep_for(kStallSleep);
+          continue;
+        }
+        done += count;
+        bytes_ += count;
+      }
+      offset += available;
+      length -= available;
+    }
+    return true;
+  }
+
+  void playRecords() {
+    uint64_t offset = sizeof(kUartCaptureMagic);
+    while (offset + sizeof(UARTCaptureRecord) <= file_.size()) {
+      size_t available;
+      const uint8_t *data =
+          file_.view(offset, sizeof(UARTCaptureRecord), available);
+      if (!data)
+        return;
+
+      UARTCaptureRecord record;
+      std::memcpy(&record, data, sizeof(record));
+      offset += sizeof(record);
+      uint64_t length =
+          std::min<uint64_t>(record.length, file_.size() - offset);
+
+      if (!waitFor(record.timestampNs) || !feed(offset, length))
+        return;
+      offset += length;
+      ++records_;
+    }
+  }
+
+  std::thread thread_;
+  std::atomic<bool> running_{false};
+  std::atomic<bool> stopRequested_{false};
+  std::atomic<uint64_t> bytes_{0};
+  std::atomic<uint64_t> records_{0};
+  std::atomic<uint64_t> stalls_{0};
+
+  // Replay thread state
+  MappedFile file_;
+  uint8_t channel_ = 0;
+  bool timed_ = false;
+  uint64_t startNs_ = 0;
+};
+
+class Replays {
+public:
+  static Replays &getInstance() {
+    static Replays instance;
+    return instance;
+  }
+
+  std::mutex mutex; // serializes start/stop
+  std::array<std::unique_ptr<Replay>, 256> channels;
+};
+} // namespace
+
+bool UARTReplay::start(uint8_t channel, const std::string &filename,
+                       bool timed) {
+  if (channel >= UART::getConfig().numChannels)
+    return false;
+
+  auto &replays = Replays::getInstance();
+  std::lock_guard<std::mutex> lock(replays.mutex);
+  auto &replay = replays.channels[channel];
+  if (!replay)
+    replay = std::make_unique<Replay>();
+  return replay->start(channel, filename, timed);
+}
+
+bool UARTReplay::stop(uint8_t channel) {
+  auto &replays = Replays::getInstance();
+  std::lock_guard<std::mutex> lock(replays.mutex);
+  auto &replay = replays.channels[channel];
+  return replay && replay->stop();
+}
+
+bool UARTReplay::isRunning(uint8_t channel) {
+  auto &replays = Replays::getInstance();
+  std::lock_guard<std::mutex> lock(replays.mutex);
+  auto &replay = replays.channels[channel];
+  return replay && replay->isRunning();
+}
+
+UARTReplay::Stats UARTReplay::getStats(uint8_t channel) {
+  auto &replays = Replays::getInstance();
+  std::lock_guard<std::mutex> lock(replays.mutex);
+  auto &replay = replays.channels[channel];
+  return replay ? replay->getStats() : Stats{};
+}
+
+} // namespace ti_sdk
\ No newline at end of file
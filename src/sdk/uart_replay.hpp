@@ -0,0 +1,55 @@
+#pragma once
+
+#include <cstdint>
+#include <string>
+
+namespace ti_sdk {
+
+// Timestamped capture files start with this magic, followed by records
+// sorted by timestamp. Files without the magic are replayed as raw bytes.
+constexpr char kUartCaptureMagic[8] = {'U', 'A', 'R', 'T', 'C', 'A', 'P', '1'};
+
+// Record header, followed by length bytes of received data
+struct UARTCaptureRecord {
+  uint64_t timestampNs; // time since the start of the capture
+  uint32_t length;
+  uint32_t reserved;
+};
+
+static_assert(sizeof(UARTCaptureRecord) == 16,
+              "UARTCaptureRecord must be packed");
+
+// Feeds captured serial traffic into a UART channel's receiver. Files are
+// streamed through a sliding memory-mapped window, so memory use does not
+// depend on the capture size. Bytes are only injected as fast as the RX
+// buffer drains, so nothing is lost to overflows; with timing enabled on
+// the channel they additionally arrive at its baud rate.
+class UARTReplay {
+public:
+  struct Stats {
+    uint64_t bytes;   // bytes delivered to RX
+    uint64_t records; // capture records delivered (timestamped files)
+    uint64_t stalls;  // waits for the firmware to make room in RX
+  };
+
+  // Start replaying a file into a channel. Timestamped captures are
+  // replayed at their recorded timing when timed is set, otherwise as fast
+  // as the channel accepts them. Fails while another source such as
+  // UARTPtyBridge feeds the channel (see UART::claimRx).
+  static bool start(uint8_t channel, const std::string &filename,
+                    bool timed = false);
+
+  // Stop the replay of a channel
+  static bool stop(uint8_t channel);
+
+  // Check if a replay is running on a channel
+  static bool isRunning(uint8_t channel);
+
+  // Get statistics of the current or last replay of a channel
+  static Stats getStats(uint8_t channel);
+
+private:
+  UARTReplay() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
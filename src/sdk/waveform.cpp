@@ -0,0 +1,332 @@
+#include "waveform.hpp"
+#include "gpio.hpp"
+#include "scheduler.hpp"
+#include <algorithm>
+#include <functional>
+#include <mutex>
+#include <queue>
+#include <unordered_map>
+
+
+namespace ti_sdk {
+
+namespace {
+// A generator that falls further behind than this skips the missed edges
+// instead of replaying them back to back
+constexpr uint64_t kMaxCatchUpNs = 1000000;
+
+constexpr size_t kMaxPorts = 256;
+
+uint32_t makePinId(uint8_t port, uint8_t pin) {
+  return (static_cast<uint32_t>(port) << 8) | pin;
+}
+
+struct Generator {
+  bool active = false;
+  uint32_t generation = 0; // invalidates queued events when bumped
+  uint8_t port = 0;
+  uint32_t mask = 0; // pins driven by this generator
+  bool isPattern = false;
+
+  // PWM timing
+  double frequencyHz = 0;
+  double dutyCycle = 0;
+  double periodNs = 0;
+  double highNs = 0;
+
+  // Pattern timing
+  std::vector<bool> bits;
+  bool loop = false;
+  double bitNs = 0;
+
+  uint64_t startNs = 0;
+  uint64_t step = 0;  // index of the next edge (PWM) or bit (pattern)
+  bool level = false; // level driven by the last event
+
+  // Absolute deadline of an event, computed from the start time so that
+  // rounding never accumulates
+  uint64_t deadline(uint64_t index) const {
+    if (isPattern)
+      return startNs + static_cast<uint64_t>(index * bitNs);
+    return startNs + static_cast<uint64_t>((index / 2) * periodNs +
+                                           ((index & 1) ? highNs : 0.0));
+  }
+
+  bool levelAt(uint64_t index) const {
+    return isPattern ? bits[index % bits.size()] : (index & 1) == 0;
+  }
+};
+
+struct Event {
+  uint64_t deadlineNs;
+  uint32_t slot;
+  uint32_t generation;
+
+  bool operator>(const Event &other) const {
+    return deadlineNs > other.deadlineNs;
+  }
+};
+
+// All generators share one TimerScheduler timer, due at the earliest
+// queued event, so that every edge due in one pass is batched into a
+// single write per port. The timer callback takes mutex with the scheduler
+// locked, so mutex must never be held while calling into TimerScheduler.
+class Engine {
+public:
+  static Engine &getInstance() {
+    static Engine instance;
+    return instance;
+  }
+
+  std::mutex mutex;
+  std::vector<Generator> generators;
+  std::unordered_map<uint32_t, uint32_t> pinSlots; // PinId -> generator
+  WaveformGenerator::Stats stats{};
+
+  // Queue a generator's next event. Requires mutex; the caller passes the
+  // returned deadline to wake once it has released mutex.
+  uint64_t schedule(uint32_t slot) {
+    const Generator &g = generators[slot];
+    uint64_t deadlineNs = g.deadline(g.step);
+    events_.push(Event{deadlineNs, slot, g.generation});
+    return deadlineNs;
+  }
+
+  // Make sure the timer fires by deadlineNs. Must not hold mutex.
+  void wake(uint64_t deadlineNs) { TimerScheduler::wake(timer_, deadlineNs); }
+
+  uint32_t allocate() {
+    if (!freeSlots_.empty()) {
+      uint32_t slot = freeSlots_.back();
+      freeSlots_.pop_back();
+      return slot;
+    }
+    generators.emplace_back();
+    return static_cast<uint32_t>(generators.size() - 1);
+  }
+
+  // Detach a pin from its generator, releasing the generator once it drives
+  // no pins. Requires mutex.
+  void removePin(uint8_t port, uint8_t pin) {
+    auto it = pinSlots.find(makePinId(port, pin));
+    if (it == pinSlots.end())
+      return;
+
+    uint32_t slot = it->second;
+    pinSlots.erase(it);
+    Generator &g = generators[slot];
+    g.mask &= ~(1u << pin);
+    if (g.mask == 0)
+      release(slot);
+  }
+
+  void release(uint32_t slot) {
+    Generator &g = generators[slot];
+    for (uint8_t pin = 0; pin < 32; ++pin) {
+      if (g.mask & (1u << pin))
+        pinSlots.erase(makePinId(g.port, pin));
+    }
+    g.active = false;
+    g.mask = 0;
+    g.bits.clear();
+    ++g.generation;
+    freeSlots_.push_back(slot);
+  }
+
+private:
+  // Creating the timer first also makes the scheduler outlive the engine
+  Engine()
+      : timer_(TimerScheduler::add(tick, this)), setMask_(kMaxPorts, 0),
+        clearMask_(kMaxPorts, 0) {}
+
+  ~Engine() { TimerScheduler::remove(timer_); }
+
+  // Timer callback: apply the due events and sleep until the next one
+  static uint64_t tick(void *context, uint64_t, uint64_t now) {
+    auto &engine = *static_cast<Engine *>(context);
+    std::lock_guard<std::mutex> lock(engine.mutex);
+    engine.processDue(now);
+    return engine.events_.empty() ? 0 : engine.events_.top().deadlineNs;
+  }
+
+  // Apply every event whose deadline has passed, one port write per port
+  void processDue(uint64_t now) {
+    while (!events_.empty() && events_.top().deadlineNs <= now) {
+      Event event = events_.top();
+      events_.pop();
+
+      Generator &g = generators[event.slot];
+      if (!g.active || g.generation != event.generation)
+        continue;
+
+      uint64_t lateness = now - event.deadlineNs;
+      stats.maxLatenessNs = std::max(stats.maxLatenessNs, lateness);
+      if (lateness > kMaxCatchUpNs) {
+        uint64_t skipped =
+            g.isPattern ? static_cast<uint64_t>(lateness / g.bitNs)
+                        : 2 * static_cast<uint64_t>(lateness / g.periodNs);
+        if (g.isPattern && !g.loop)
+          skipped = std::min<uint64_t>(skipped, g.bits.size() - 1 - g.step);
+        g.step += skipped;
+        stats.missedEvents += skipped;
+      }
+
+      g.level = g.levelAt(g.step);
+      uint32_t &set = setMask_[g.port];
+      uint32_t &clear = clearMask_[g.port];
+      if ((set | clear) == 0)
+        touched_.push_back(g.port);
+      if (g.level) {
+        set |= g.mask;
+        clear &= ~g.mask;
+      } else {
+        clear |= g.mask;
+        set &= ~g.mask;
+      }
+      ++stats.events;
+
+      ++g.step;
+      if (g.isPattern && !g.loop && g.step >= g.bits.size()) {
+        release(event.slot);
+      } else {
+        events_.push(Event{g.deadline(g.step), event.slot, g.generation});
+      }
+    }
+
+    for (uint8_t port : touched_) {
+      GPIO::writePortMasked(port, setMask_[port] | clearMask_[port],
+                            setMask_[port]);
+      setMask_[port] = 0;
+      clearMask_[port] = 0;
+    }
+    touched_.clear();
+  }
+
+  uint32_t timer_;
+  std::vector<uint32_t> freeSlots_;
+  std::priority_queue<Event, std::vector<Event>, std::greater<Event>> events_;
+
+  // Per-port write batch of the current pass
+  std::vector<uint32_t> setMask_;
+  std::vector<uint32_t> clearMask_;
+  std::vector<uint8_t> touched_;
+};
+
+bool isOutput(uint8_t port, uint8_t pin) {
+  return pin < GPIO::getConfig().pinsPerPort &&
+         GPIO::getPinMode(port, pin) == PinMode::OUTPUT;
+}
+} // namespace
+
+bool WaveformGenerator::startPWM(uint8_t port, uint8_t pin, double frequencyHz,
+                                 double dutyCycle) {
+  if (!isOutput(port, pin) || !(frequencyHz > 0) || dutyCycle < 0 ||
+      dutyCycle > 1)
+    return false;
+
+  auto &engine = Engine::getInstance();
+  uint64_t deadlineNs;
+  {
+    std::lock_guard<std::mutex> lock(engine.mutex);
+    engine.removePin(port, pin);
+
+    uint32_t bit = 1u << pin;
+    if (dutyCycle == 0 || dutyCycle == 1) {
+      // A constant level needs no scheduling
+      return GPIO::writePortMasked(port, bit, dutyCycle == 1 ? bit : 0);
+    }
+
+    // Join a running generator with identical timing on the same port
+    for (uint32_t slot = 0; slot < engine.generators.size(); ++slot) {
+      Generator &g = engine.generators[slot];
+      if (g.active && !g.isPattern && g.port == port &&
+          g.frequencyHz == frequencyHz && g.dutyCycle == dutyCycle) {
+        g.mask |= bit;
+        engine.pinSlots[makePinId(port, pin)] = slot;
+        return GPIO::writePortMasked(port, bit, g.level ? bit : 0);
+      }
+    }
+
+    uint32_t slot = engine.allocate();
+    Generator &g = engine.generators[slot];
+    g.active = true;
+    g.port = port;
+    g.mask = bit;
+    g.isPattern = false;
+    g.frequencyHz = frequencyHz;
+    g.dutyCycle = dutyCycle;
+    g.periodNs = 1e9 / frequencyHz;
+    g.highNs = g.periodNs * dutyCycle;
+    g.startNs = TimerScheduler::nowNs();
+    g.step = 0;
+    g.level = false;
+    engine.pinSlots[makePinId(port, pin)] = slot;
+    deadlineNs = engine.schedule(slot);
+  }
+  engine.wake(deadlineNs);
+  return true;
+}
+
+bool WaveformGenerator::startPattern(uint8_t port, uint8_t pin, double bitRate,
+                                     const std::vector<bool> &bits,
+                                     bool loop) {
+  if (!isOutput(port, pin) || !(bitRate > 0) || bits.empty())
+    return false;
+
+  auto &engine = Engine::getInstance();
+  uint64_t deadlineNs;
+  {
+    std::lock_guard<std::mutex> lock(engine.mutex);
+    engine.removePin(port, pin);
+
+    uint32_t slot = engine.allocate();
+    Generator &g = engine.generators[slot];
+    g.active = true;
+    g.port = port;
+    g.mask = 1u << pin;
+    g.isPattern = true;
+    g.bits = bits;
+    g.loop = loop;
+    g.bitNs = 1e9 / bitRate;
+    g.startNs = TimerScheduler::nowNs();
+    g.step = 0;
+    g.level = false;
+    engine.pinSlots[makePinId(port, pin)] = slot;
+    deadlineNs = engine.schedule(slot);
+  }
+  engine.wake(deadlineNs);
+  return true;
+}
+
+bool WaveformGenerator::stop(uint8_t port, uint8_t pin) {
+  auto &engine = Engine::getInstance();
+  std::lock_guard<std::mutex> lock(engine.mutex);
+  if (!engine.pinSlots.count(makePinId(port, pin)))
+    return false;
+
+  engine.removePin(port, pin);
+  return true;
+}
+
+void WaveformGenerator::stopAll() {
+  auto &engine = Engine::getInstance();
+  std::lock_guard<std::mutex> lock(engine.mutex);
+  for (uint32_t slot = 0; slot < engine.generators.size(); ++slot) {
+    if (engine.generators[slot].active)
+      engine.release(slot);
+  }
+}
+
+bool WaveformGenerator::isRunning(uint8_t port, uint8_t pin) {
+  auto &engine = Engine::getInstance();
+  std::lock_guard<std::mutex> lock(engine.mutex);
+  return engine.pinSlots.count(makePinId(port, pin)) != 0;
+}
+
+WaveformGenerator::Stats WaveformGenerator::getStats() {
+  auto &engine = Engine::getInstance();
+  std::lock_guard<std::mutex> lock(engine.mutex);
+  return engine.stats;
+}
+
+} // namespace ti_sdk
\ No newline at end of file
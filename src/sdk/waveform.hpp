@@ -0,0 +1,47 @@
+#pragma once
+
+#include <cstdint>
+#include <vector>
+
+namespace ti_sdk {
+
+// Drives PWM and bit-pattern waveforms on GPIO output pins from the shared
+// TimerScheduler thread. Edges are scheduled on absolute deadlines and all
+// edges due at the same time on one port are applied with a single
+// GPIO::writePortMasked call.
+class WaveformGenerator {
+public:
+  struct Stats {
+    uint64_t events;        // scheduled edges/bits processed
+    uint64_t missedEvents;  // edges skipped after falling behind
+    uint64_t maxLatenessNs; // worst delay between deadline and write
+  };
+
+  // Drive a PWM signal on an output pin (dutyCycle between 0 and 1).
+  // Pins of the same port started with the same frequency and duty cycle
+  // share one generator and stay in phase, like the channels of a hardware
+  // timer.
+  static bool startPWM(uint8_t port, uint8_t pin, double frequencyHz,
+                       double dutyCycle);
+
+  // Clock a bit pattern out of an output pin at bitRate bits per second
+  static bool startPattern(uint8_t port, uint8_t pin, double bitRate,
+                           const std::vector<bool> &bits, bool loop = true);
+
+  // Stop the waveform on a pin, leaving the pin at its current level
+  static bool stop(uint8_t port, uint8_t pin);
+
+  // Stop all waveforms
+  static void stopAll();
+
+  // Check if a waveform is running on a pin
+  static bool isRunning(uint8_t port, uint8_t pin);
+
+  // Get scheduler statistics
+  static Stats getStats();
+
+private:
+  WaveformGenerator() = delete; // Prevent instantiation
+};
+
+} // namespace ti_sdk
\ No newline at end of file
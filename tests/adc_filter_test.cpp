@@ -0,0 +1,90 @@
+#include "sdk/adc_filter.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+namespace {
+std::vector<uint16_t> run(FilterPipeline &filter,
+                          const std::vector<uint16_t> &in) {
+  size_t count = in.size() / filter.getConfig().oversampling;
+  std::vector<uint16_t> out(count);
+  filter.process(in.data(), out.data(), count, *selectADCKernels(16));
+  return out;
+}
+} // namespace
+
+TEST(FilterPipelineTest, RejectsInvalidConfig) {
+  FilterPipeline filter;
+  FilterConfig config;
+  config.oversampling = 0;
+  EXPECT_FALSE(filter.configure(config));
+  config.oversampling = 1024;
+  config.cicOrder = 5;
+  EXPECT_FALSE(filter.configure(config));
+  config.cicOrder = 4;
+  EXPECT_TRUE(filter.configure(config));
+  config.firTaps = 31;
+  config.firCutoff = 0.5;
+  EXPECT_FALSE(filter.configure(config));
+  config.firCutoff = 0.1;
+  config.iirCutoff = -1;
+  EXPECT_FALSE(filter.configure(config));
+  EXPECT_EQ(filter.getConfig().cicOrder, 4);
+  EXPECT_EQ(filter.getConfig().firTaps, 0u);
+}
+
+TEST(FilterPipelineTest, DecimatorsAverageBlocks) {
+  FilterPipeline filter;
+  EXPECT_FALSE(filter.isEnabled());
+  FilterConfig config;
+  config.oversampling = 4;
+  ASSERT_TRUE(filter.configure(config));
+  EXPECT_TRUE(filter.isEnabled());
+  EXPECT_EQ(run(filter, {1, 2, 3, 4, 10, 10, 10, 14}),
+            (std::vector<uint16_t>{3, 11}));
+
+  // Higher orders settle to the input level after order blocks, even when
+  // the integrators wrap around
+  config.oversampling = 64;
+  config.cicOrder = 5;
+  ASSERT_TRUE(filter.configure(config));
+  std::vector<uint16_t> in(64 * 1000, 60000);
+  auto out = run(filter, in);
+  for (size_t i = 5; i < out.size(); ++i)
+    ASSERT_EQ(out[i], 60000) << "sample " << i;
+}
+
+TEST(FilterPipelineTest, LowPassesKeepDCAndRemoveNyquist) {
+  FilterConfig config;
+  config.firTaps = 63;
+  config.firCutoff = 0.1;
+  FilterPipeline fir;
+  ASSERT_TRUE(fir.configure(config));
+
+  config.firTaps = 0;
+  config.iirCutoff = 0.05;
+  FilterPipeline iir;
+  ASSERT_TRUE(iir.configure(config));
+
+  // A tone at half the sample rate around a DC level
+  std::vector<uint16_t> in(2000);
+  for (size_t i = 0; i < in.size(); ++i)
+    in[i] = i % 2 ? 1500 : 2500;
+  for (FilterPipeline *filter : {&fir, &iir}) {
+    auto out = run(*filter, in);
+    for (size_t i = 200; i < out.size(); ++i)
+      ASSERT_NEAR(out[i], 2000, 2) << "sample " << i;
+  }
+}
+
+TEST(FilterPipelineTest, MedianRemovesSpikes) {
+  FilterConfig config;
+  config.medianWindow = 5;
+  FilterPipeline filter;
+  ASSERT_TRUE(filter.configure(config));
+  EXPECT_EQ(run(filter, {100, 100, 4000, 100, 0, 100, 100, 100}),
+            (std::vector<uint16_t>{100, 100, 100, 100, 100, 100, 100, 100}));
+}
\ No newline at end of file
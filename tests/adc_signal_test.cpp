@@ -0,0 +1,86 @@
+#include "sdk/adc_signal.hpp"
+#include <cmath>
+#include <gtest/gtest.h>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+namespace {
+std::vector<uint16_t> generate(SignalGenerator &generator, size_t count,
+                               uint8_t resolution = 12) {
+  std::vector<uint16_t> samples(count);
+  generator.generate(samples.data(), count, *selectADCKernels(resolution));
+  return samples;
+}
+} // namespace
+
+TEST(SignalGeneratorTest, NoiseIsReproduciblePerSeed) {
+  SignalGenerator a(7), b(7), c(8);
+  auto first = generate(a, 1000);
+  EXPECT_EQ(first, generate(b, 1000));
+  EXPECT_NE(first, generate(c, 1000));
+
+  a.restart();
+  EXPECT_EQ(generate(a, 1000), first);
+
+  // Uniform noise around the default mid-scale offset
+  double sum = 0;
+  for (uint16_t value : generate(a, 100000)) {
+    ASSERT_GE(value, 1998);
+    ASSERT_LE(value, 2098);
+    sum += value;
+  }
+  EXPECT_NEAR(sum / 100000, 2048, 1);
+}
+
+TEST(SignalGeneratorTest, SineFollowsPhasor) {
+  SignalModel model;
+  model.shape = SignalShape::SINE;
+  model.amplitude = 1000;
+  model.frequencyHz = 1000;
+  model.noise = 0;
+  SignalGenerator generator;
+  generator.setModel(model, 48000);
+
+  // Long runs stay on the unit circle
+  auto samples = generate(generator, 480000);
+  for (size_t i = 0; i < samples.size(); i += 97) {
+    double expected = 2048 + 1000 * std::sin(6.283185307179586 * i / 48);
+    ASSERT_NEAR(samples[i], expected, 1) << "sample " << i;
+  }
+}
+
+TEST(SignalGeneratorTest, RampSquareAndTones) {
+  SignalModel model;
+  model.shape = SignalShape::RAMP;
+  model.offset = 100;
+  model.amplitude = 100;
+  model.frequencyHz = 1;
+  model.noise = 0;
+  SignalGenerator generator;
+  generator.setModel(model, 4);
+  EXPECT_EQ(generate(generator, 5),
+            (std::vector<uint16_t>{0, 50, 100, 150, 0}));
+
+  model.shape = SignalShape::SQUARE;
+  generator.setModel(model, 4);
+  EXPECT_EQ(generate(generator, 4), (std::vector<uint16_t>{200, 200, 0, 0}));
+
+  model.shape = SignalShape::DC;
+  model.tones = {{10, 1, 0}, {20, 1, 1.5707963267948966}};
+  generator.setModel(model, 4);
+  EXPECT_EQ(generate(generator, 4),
+            (std::vector<uint16_t>{120, 110, 80, 90}));
+}
+
+TEST(SignalGeneratorTest, ClampsToConverterRange) {
+  SignalModel model;
+  model.shape = SignalShape::SQUARE;
+  model.offset = 128;
+  model.amplitude = 1000;
+  model.frequencyHz = 1;
+  SignalGenerator generator;
+  generator.setModel(model, 2);
+  EXPECT_EQ(generate(generator, 2, 8), (std::vector<uint16_t>{255, 0}));
+}
\ No newline at end of file
@@ -0,0 +1,384 @@
+#include "sdk/adc.hpp"
+#include "sdk/interrupt.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <cmath>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+namespace {
+std::atomic<uint64_t> callbackSamples{0};
+void countSample(uint16_t) { ++callbackSamples; }
+
+struct BlockLog {
+  std::atomic<uint64_t> blocks{0};
+  std::atomic<uint64_t> overruns{0};
+  std::atomic<bool> valid{true};
+  uint64_t lastTimestampNs = 0;
+  uint64_t minGapNs = UINT64_MAX;
+  uint64_t maxGapNs = 0;
+  std::chrono::milliseconds delay{0};
+};
+
+void logBlock(const ADC::SampleBlock &block, void *context) {
+  auto &log = *static_cast<BlockLog *>(context);
+  for (size_t i = 0; i < block.size; ++i) {
+    if (block.data[i] < 1998 || block.data[i] > 2098)
+      log.valid = false;
+  }
+  if (log.lastTimestampNs != 0 && block.overruns == 0) {
+    uint64_t gap = block.timestampNs - log.lastTimestampNs;
+    log.minGapNs = std::min(log.minGapNs, gap);
+    log.maxGapNs = std::max(log.maxGapNs, gap);
+  }
+  log.lastTimestampNs = block.timestampNs;
+  log.overruns += block.overruns;
+  ++log.blocks;
+  std::this_thread::sleep_for(log.delay);
+}
+} // namespace
+
+class ADCTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_TRUE(ADC::initialize());
+    callbackSamples = 0;
+  }
+
+  void TearDown() override { ADC::initialize(); }
+};
+
+TEST_F(ADCTest, ReadRequiresConfiguredChannel) {
+  EXPECT_EQ(ADC::read(0), 0);
+  ASSERT_TRUE(ADC::configureChannel(0, 1000));
+  uint16_t value = ADC::read(0);
+  EXPECT_GE(value, 1998);
+  EXPECT_LE(value, 2098);
+  EXPECT_FALSE(ADC::configureChannel(ADC::getConfig().numChannels, 1000));
+}
+
+TEST_F(ADCTest, ChannelCountFromConfig) {
+  ADCConfig config = ADC::getConfig();
+  config.numChannels = 2;
+  ASSERT_TRUE(ADC::initialize(config));
+  EXPECT_TRUE(ADC::configureChannel(1, 1000));
+  EXPECT_FALSE(ADC::configureChannel(2, 1000));
+}
+
+TEST_F(ADCTest, ContinuousKeepsRate) {
+  ASSERT_TRUE(ADC::configureChannel(0, 10000));
+  ASSERT_TRUE(ADC::configureChannel(1, 2000));
+  ASSERT_TRUE(ADC::startContinuous(0, countSample));
+  ASSERT_TRUE(ADC::startContinuous(1, nullptr));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_TRUE(ADC::stopContinuous(0));
+  ASSERT_TRUE(ADC::stopContinuous(1));
+
+  // Deadlines are absolute, so missed and taken samples add up to the
+  // nominal count regardless of how late individual ticks ran
+  auto fast = ADC::getStats(0);
+  auto slow = ADC::getStats(1);
+  EXPECT_NEAR(fast.samples + fast.missedDeadlines, 2000, 200);
+  EXPECT_NEAR(slow.samples + slow.missedDeadlines, 400, 40);
+  EXPECT_EQ(callbackSamples.load(), fast.samples);
+  EXPECT_GE(fast.maxJitterNs, fast.meanJitterNs);
+
+  // Nothing runs after stopping
+  uint64_t samples = callbackSamples.load();
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(callbackSamples.load(), samples);
+}
+
+TEST_F(ADCTest, RestartResetsStats) {
+  ASSERT_TRUE(ADC::configureChannel(3, 1000));
+  ASSERT_TRUE(ADC::startContinuous(3, nullptr));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(ADC::startContinuous(3, nullptr));
+  EXPECT_LE(ADC::getStats(3).samples, 2u);
+  EXPECT_TRUE(ADC::stopContinuous(3));
+}
+
+TEST_F(ADCTest, SaveAndRestoreState) {
+  ASSERT_TRUE(ADC::configureChannel(5, 4000));
+  std::string state = ADC::saveState();
+  ASSERT_TRUE(ADC::initialize());
+  EXPECT_EQ(ADC::read(5), 0);
+  ASSERT_TRUE(ADC::restoreState(state));
+  EXPECT_NE(ADC::read(5), 0);
+  EXPECT_FALSE(ADC::restoreState("{\"initialized\":true,\"channels\":"
+                                 "{\"200\":{\"sampleRate\":1,"
+                                 "\"lastValue\":0}}}"));
+}
+
+TEST_F(ADCTest, ReadBlockFillsBuffer) {
+  std::vector<uint16_t> block(1 << 20, 0);
+  EXPECT_EQ(ADC::readBlock(2, block.data(), block.size()), 0u);
+  ASSERT_TRUE(ADC::configureChannel(2, 1000));
+  ASSERT_EQ(ADC::readBlock(2, block.data(), block.size()), block.size());
+  for (uint16_t value : block) {
+    ASSERT_GE(value, 1998);
+    ASSERT_LE(value, 2098);
+  }
+  EXPECT_NE(ADC::readAverage(2, 16), 0);
+}
+
+TEST_F(ADCTest, DMAFillsBlocksAndStops) {
+  std::atomic<int> completed{0};
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::ADC_COMPLETE, 4,
+                             [&completed] { ++completed; });
+  interrupts.start();
+
+  std::vector<uint16_t> buffer(4 * 64, 0);
+  ASSERT_TRUE(ADC::configureChannel(4, 100000));
+  ASSERT_TRUE(ADC::startDMA(4, buffer.data(), 64, 4, false));
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (completed < 4 && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  interrupts.stop();
+  interrupts.detachInterrupt(InterruptType::ADC_COMPLETE, 4);
+
+  // A one-shot transfer stops after its last block
+  EXPECT_EQ(completed, 4);
+  auto stats = ADC::getStats(4);
+  EXPECT_EQ(stats.blocks, 4u);
+  EXPECT_EQ(stats.samples, buffer.size());
+  for (uint16_t value : buffer)
+    ASSERT_NE(value, 0);
+  EXPECT_TRUE(ADC::stopContinuous(4));
+}
+
+TEST_F(ADCTest, CircularDMAWraps) {
+  std::vector<uint16_t> buffer(2 * 32, 0);
+  ASSERT_TRUE(ADC::configureChannel(6, 50000));
+  ASSERT_TRUE(ADC::startDMA(6, buffer.data(), 32, 2));
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  ASSERT_TRUE(ADC::stopContinuous(6));
+  EXPECT_GT(ADC::getStats(6).blocks, 2u);
+
+  ADCConfig config = ADC::getConfig();
+  config.hasDMA = false;
+  ASSERT_TRUE(ADC::initialize(config));
+  ASSERT_TRUE(ADC::configureChannel(6, 50000));
+  EXPECT_FALSE(ADC::startDMA(6, buffer.data(), 32, 2));
+}
+
+TEST_F(ADCTest, SeededChannelsAreReproducible) {
+  SignalModel model;
+  model.shape = SignalShape::SINE;
+  model.amplitude = 500;
+  model.frequencyHz = 50;
+  ASSERT_TRUE(ADC::configureChannel(0, 1000));
+  ASSERT_TRUE(ADC::configureChannel(1, 1000));
+  ASSERT_TRUE(ADC::setSignal(0, model));
+  ASSERT_TRUE(ADC::setSignal(1, model));
+
+  // Channels default to different seeds
+  std::vector<uint16_t> a(256), b(256);
+  ADC::readBlock(0, a.data(), a.size());
+  ADC::readBlock(1, b.data(), b.size());
+  EXPECT_NE(a, b);
+
+  ASSERT_TRUE(ADC::setSeed(0, 42));
+  ASSERT_TRUE(ADC::setSeed(1, 42));
+  ADC::readBlock(0, a.data(), a.size());
+  ADC::readBlock(1, b.data(), b.size());
+  EXPECT_EQ(a, b);
+  EXPECT_NEAR(a[5], 2048 + 500 * std::sin(6.283185307179586 * 5 / 20), 51);
+}
+
+TEST_F(ADCTest, NoiseDoesNotDependOnReadSplit) {
+  ASSERT_TRUE(ADC::configureChannel(0, 1000));
+
+  // One block of 11 samples, eleven single reads, and 3 + 8 samples must
+  // produce the same sequence, including across partial noise groups
+  ASSERT_TRUE(ADC::setSeed(0, 42));
+  std::vector<uint16_t> block(11);
+  ASSERT_EQ(ADC::readBlock(0, block.data(), block.size()), block.size());
+
+  ASSERT_TRUE(ADC::setSeed(0, 42));
+  std::vector<uint16_t> single(11);
+  for (auto &sample : single)
+    sample = ADC::read(0);
+  EXPECT_EQ(single, block);
+
+  ASSERT_TRUE(ADC::setSeed(0, 42));
+  std::vector<uint16_t> split(11);
+  ASSERT_EQ(ADC::readBlock(0, split.data(), 3), 3u);
+  ASSERT_EQ(ADC::readBlock(0, split.data() + 3, 8), 8u);
+  EXPECT_EQ(split, block);
+}
+
+TEST_F(ADCTest, OversamplingReducesNoise) {
+  auto spread = [](uint8_t channel) {
+    std::vector<uint16_t> block(4096);
+    ADC::readBlock(channel, block.data(), block.size());
+    auto [min, max] = std::minmax_element(block.begin(), block.end());
+    return *max - *min;
+  };
+  ASSERT_TRUE(ADC::configureChannel(7, 1000));
+  int raw = spread(7);
+
+  FilterConfig config;
+  config.oversampling = 64;
+  ASSERT_TRUE(ADC::setFilter(7, config));
+  EXPECT_EQ(ADC::getFilter(7).oversampling, 64u);
+  EXPECT_LT(spread(7) * 3, raw);
+
+  config.oversampling = 0;
+  EXPECT_FALSE(ADC::setFilter(7, config));
+  EXPECT_EQ(ADC::getFilter(7).oversampling, 64u);
+}
+
+TEST_F(ADCTest, BlockCallbacksGetConsecutiveBlocks) {
+  BlockLog log;
+  ASSERT_TRUE(ADC::configureChannel(8, 10000));
+  EXPECT_FALSE(ADC::startBlocks(8, 0, logBlock, &log));
+  ASSERT_TRUE(ADC::startBlocks(8, 100, logBlock, &log));
+  std::this_thread::sleep_for(std::chrono::milliseconds(100));
+  ASSERT_TRUE(ADC::stopContinuous(8));
+
+  // The callback no longer runs once stopped
+  uint64_t blocks = log.blocks;
+  std::this_thread::sleep_for(std::chrono::milliseconds(20));
+  EXPECT_EQ(log.blocks, blocks);
+  EXPECT_GE(blocks, 8u);
+  EXPECT_TRUE(log.valid);
+
+  // Blocks of 100 samples follow each other every 10 ms, unless sampling
+  // fell behind and skipped samples
+  EXPECT_GE(log.minGapNs, 9900000u);
+  if (ADC::getStats(8).missedDeadlines == 0) {
+    EXPECT_LE(log.maxGapNs, 10100000u);
+  }
+  EXPECT_EQ(ADC::getStats(8).blocks, blocks + ADC::getStats(8).overruns);
+}
+
+TEST_F(ADCTest, SlowBlockConsumerCausesOverruns) {
+  BlockLog log;
+  log.delay = std::chrono::milliseconds(30);
+  ASSERT_TRUE(ADC::configureChannel(9, 10000));
+  ASSERT_TRUE(ADC::startBlocks(9, 100, logBlock, &log));
+  std::this_thread::sleep_for(std::chrono::milliseconds(200));
+  ASSERT_TRUE(ADC::stopContinuous(9));
+
+  // Sampling kept its rate while the consumer fell behind
+  auto stats = ADC::getStats(9);
+  EXPECT_NEAR(stats.samples + stats.missedDeadlines, 2000, 200);
+  EXPECT_GT(stats.overruns, 0u);
+  // Overruns after the last delivery are only in the stats
+  EXPECT_LE(log.overruns + log.blocks, stats.blocks);
+  EXPECT_TRUE(log.valid);
+}
+
+TEST_F(ADCTest, WindowComparatorCountsCrossings) {
+  std::atomic<int> raised{0};
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::ADC_WINDOW, 10,
+                             [&raised] { ++raised; });
+  interrupts.start();
+
+  // A noiseless square wave between 1048 and 3048, 50 samples per level
+  SignalModel model;
+  model.shape = SignalShape::SQUARE;
+  model.amplitude = 1000;
+  model.frequencyHz = 10;
+  model.noise = 0;
+  ASSERT_TRUE(ADC::configureChannel(10, 1000));
+  ASSERT_TRUE(ADC::setSignal(10, model));
+  EXPECT_FALSE(ADC::setWindow(10, 3000, 1000));
+  EXPECT_FALSE(ADC::setWindow(10, 1000, 3000, 1001));
+
+  // Only the high level leaves the window, once per period
+  ASSERT_TRUE(ADC::setWindow(10, 1000, 3000, 10));
+  std::vector<uint16_t> block(1000);
+  ASSERT_EQ(ADC::readBlock(10, block.data(), block.size()), block.size());
+  auto status = ADC::getWindowStatus(10);
+  EXPECT_EQ(status.crossings, 10u);
+  EXPECT_EQ(status.value, 3048);
+  EXPECT_FALSE(status.outside);
+
+  // Without hysteresis room to re-arm, the comparator stays tripped
+  ASSERT_TRUE(ADC::setWindow(10, 1100, 3000, 950));
+  ASSERT_EQ(ADC::readBlock(10, block.data(), block.size()), block.size());
+  status = ADC::getWindowStatus(10);
+  EXPECT_EQ(status.crossings, 1u);
+  EXPECT_TRUE(status.outside);
+  EXPECT_TRUE(ADC::clearWindow(10));
+  EXPECT_FALSE(ADC::clearWindow(10));
+
+  // Crossings raised while the interrupt is still pending coalesce
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while ((raised < 1 ||
+          interrupts.isPending(InterruptType::ADC_WINDOW, 10)) &&
+         std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  interrupts.stop();
+  interrupts.detachInterrupt(InterruptType::ADC_WINDOW, 10);
+  EXPECT_GE(raised, 1);
+  EXPECT_LE(raised, 11);
+}
+
+TEST_F(ADCTest, ResolutionSetsCodeRange) {
+  ADCConfig config = ADC::getConfig();
+  config.resolution = 11;
+  EXPECT_FALSE(ADC::initialize(config));
+
+  for (uint8_t bits : {8, 10, 12, 14, 16}) {
+    config.resolution = bits;
+    ASSERT_TRUE(ADC::initialize(config));
+    ASSERT_TRUE(ADC::configureChannel(0, 1000));
+    uint32_t maxCode = (1u << bits) - 1;
+    EXPECT_NEAR(ADC::readAverage(0, 200), (maxCode + 1) / 2,
+                (maxCode + 1) / 256.0)
+        << int(bits) << " bits";
+
+    // A full-swing square clips at both rails
+    SignalModel model = ADC::getSignal(0);
+    model.shape = SignalShape::SQUARE;
+    model.amplitude = 100000;
+    model.frequencyHz = 100;
+    ASSERT_TRUE(ADC::setSignal(0, model));
+    std::vector<uint16_t> block(10);
+    ADC::readBlock(0, block.data(), block.size());
+    EXPECT_EQ(block[0], maxCode);
+    EXPECT_EQ(block[9], 0);
+    if (bits < 16) {
+      EXPECT_FALSE(ADC::setWindow(0, 0, maxCode + 1));
+    }
+  }
+}
+
+TEST_F(ADCTest, RejectsRatesAboveMaximum) {
+  uint32_t maxRate = ADC::getConfig().maxSampleRate;
+  EXPECT_FALSE(ADC::configureChannel(0, maxRate + 1));
+  ASSERT_TRUE(ADC::configureChannel(0, maxRate / 4));
+
+  // Oversampling counts towards the conversion rate
+  FilterConfig filter;
+  filter.oversampling = 8;
+  EXPECT_FALSE(ADC::setFilter(0, filter));
+  filter.oversampling = 4;
+  ASSERT_TRUE(ADC::setFilter(0, filter));
+  EXPECT_FALSE(ADC::configureChannel(0, maxRate / 2));
+  EXPECT_EQ(ADC::getFilter(0).oversampling, 4u);
+}
+
+TEST_F(ADCTest, RestoreRescalesResolution) {
+  ASSERT_TRUE(ADC::configureChannel(1, 1000));
+  ADC::read(1);
+  std::string state = ADC::saveState();
+
+  ADCConfig config = ADC::getConfig();
+  config.resolution = 16;
+  ASSERT_TRUE(ADC::initialize(config));
+  ASSERT_TRUE(ADC::restoreState(state));
+  EXPECT_NEAR(ADC::readAverage(1, 100), 32768, 256);
+  std::string restored = ADC::saveState();
+  EXPECT_NE(restored.find("\"resolution\":16"), std::string::npos);
+}
\ No newline at end of file
@@ -0,0 +1,107 @@
+#include "sdk/adc.hpp"
+#include "sdk/adc_trace.hpp"
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+class ADCTraceTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ADC::initialize();
+    filename_ = ::testing::TempDir() + "adc_trace_test.dat";
+    csvFilename_ = ::testing::TempDir() + "adc_trace_test.csv";
+  }
+
+  void TearDown() override {
+    ADC::initialize();
+    std::remove(filename_.c_str());
+    std::remove(csvFilename_.c_str());
+  }
+
+  void writeRaw(const std::vector<uint16_t> &samples) {
+    std::ofstream file(filename_, std::ios::binary);
+    file.write(reinterpret_cast<const char *>(samples.data()),
+               samples.size() * sizeof(uint16_t));
+  }
+
+  std::string filename_;
+  std::string csvFilename_;
+};
+
+TEST_F(ADCTraceTest, ServesSamplesAcrossWindows) {
+  // 4 MiB of samples, several times the mapped window
+  std::vector<uint16_t> samples(2 << 20);
+  for (size_t i = 0; i < samples.size(); ++i)
+    samples[i] = static_cast<uint16_t>(i * 7);
+  writeRaw(samples);
+
+  TraceSource trace;
+  ASSERT_TRUE(trace.open(filename_, false));
+  EXPECT_EQ(trace.length(), samples.size());
+
+  std::vector<uint16_t> out(samples.size() + 10);
+  for (size_t done = 0; done < out.size();) {
+    size_t n = std::min<size_t>(out.size() - done, 99991);
+    trace.read(out.data() + done, n, *selectADCKernels(16));
+    done += n;
+  }
+  EXPECT_TRUE(std::equal(samples.begin(), samples.end(), out.begin()));
+  EXPECT_TRUE(trace.finished());
+
+  // Finished traces hold the last sample
+  for (size_t i = samples.size(); i < out.size(); ++i)
+    EXPECT_EQ(out[i], samples.back());
+}
+
+TEST_F(ADCTraceTest, LoopsAndClamps) {
+  writeRaw({1, 2, 5000});
+  TraceSource trace;
+  ASSERT_TRUE(trace.open(filename_, true));
+  std::vector<uint16_t> out(7);
+  trace.read(out.data(), out.size(), *selectADCKernels(12));
+  EXPECT_EQ(out, (std::vector<uint16_t>{1, 2, 4095, 1, 2, 4095, 1}));
+  EXPECT_FALSE(trace.finished());
+  EXPECT_EQ(trace.position(), 1u);
+
+  writeRaw({});
+  EXPECT_FALSE(trace.open(filename_, true));
+}
+
+TEST_F(ADCTraceTest, ConvertsCsv) {
+  {
+    std::ofstream csv(csvFilename_);
+    csv << "time,value\n0.000,100\n0.001,200.4\n\n0.002,4000\n";
+  }
+  ASSERT_TRUE(convertCsvTrace(csvFilename_, filename_, 1000, 12));
+
+  TraceSource trace;
+  ASSERT_TRUE(trace.open(filename_, false));
+  EXPECT_EQ(trace.getHeader().sampleRate, 1000u);
+  EXPECT_EQ(trace.getHeader().resolution, 12);
+  ASSERT_EQ(trace.length(), 3u);
+  std::vector<uint16_t> out(3);
+  trace.read(out.data(), out.size(), *selectADCKernels(12));
+  EXPECT_EQ(out, (std::vector<uint16_t>{100, 200, 4000}));
+}
+
+TEST_F(ADCTraceTest, ChannelPlaysTrace) {
+  writeRaw({10, 20, 30, 40});
+  ASSERT_TRUE(ADC::configureChannel(3, 1000));
+  EXPECT_FALSE(ADC::playTrace(3, filename_ + ".missing"));
+  ASSERT_TRUE(ADC::playTrace(3, filename_));
+  EXPECT_TRUE(ADC::isTracePlaying(3));
+
+  std::vector<uint16_t> out(6);
+  ASSERT_EQ(ADC::readBlock(3, out.data(), out.size()), out.size());
+  EXPECT_EQ(out, (std::vector<uint16_t>{10, 20, 30, 40, 40, 40}));
+  EXPECT_FALSE(ADC::isTracePlaying(3));
+
+  // Back to the default signal model
+  EXPECT_TRUE(ADC::stopTrace(3));
+  EXPECT_FALSE(ADC::stopTrace(3));
+  EXPECT_GT(ADC::read(3), 1000);
+}
\ No newline at end of file
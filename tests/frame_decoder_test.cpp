@@ -0,0 +1,147 @@
+#include "sdk/frame_decoder.hpp"
+#include "sdk/uart.hpp"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+
+using namespace ti_sdk;
+
+namespace {
+using Frames = std::vector<std::string>;
+
+std::unique_ptr<FrameDecoder> makeDecoder(FramingMode mode, Frames &frames,
+                                          size_t maxFrameSize = 4096) {
+  return std::make_unique<FrameDecoder>(
+      mode,
+      [&frames](const uint8_t *data, size_t size) {
+        frames.emplace_back(reinterpret_cast<const char *>(data), size);
+      },
+      maxFrameSize);
+}
+
+void feed(FrameDecoder &decoder, const std::string &bytes) {
+  decoder.feed(reinterpret_cast<const uint8_t *>(bytes.data()), bytes.size());
+}
+} // namespace
+
+TEST(FrameDecoderTest, LinesSplitAcrossFeeds) {
+  Frames frames;
+  auto decoder = makeDecoder(FramingMode::LINE, frames);
+  feed(*decoder, "AT+CSQ\r\n\r\n+CSQ: 2");
+  feed(*decoder, "1,99\r\nOK\r\nERR");
+
+  EXPECT_EQ(frames, (Frames{"AT+CSQ", "+CSQ: 21,99", "OK"}));
+  EXPECT_EQ(decoder->getStats().frames, 3u);
+}
+
+TEST(FrameDecoderTest, SlipUnescapes) {
+  Frames frames;
+  auto decoder = makeDecoder(FramingMode::SLIP, frames);
+  feed(*decoder, std::string("\xC0"
+                             "ab\xDB\xDC"
+                             "c\xDB\xDD\xC0\xC0"
+                             "plain\xC0"
+                             "bad\xDB"
+                             "x\xC0"));
+
+  EXPECT_EQ(frames, (Frames{std::string("ab\xC0"
+                                        "c\xDB"),
+                            "plain"}));
+  EXPECT_EQ(decoder->getStats().errors, 1u);
+}
+
+TEST(FrameDecoderTest, CobsDecodes) {
+  Frames frames;
+  auto decoder = makeDecoder(FramingMode::COBS, frames);
+  // {0x11, 0x00, 0x22} and a 254-byte block without zeros
+  feed(*decoder, std::string("\x02\x11\x02\x22", 4) + std::string(1, '\0'));
+  std::string block(1, '\xFF');
+  block += std::string(254, 'z');
+  block += '\x01';
+  feed(*decoder, block + std::string(1, '\0'));
+  feed(*decoder, std::string("\x05\x01", 2) + std::string(1, '\0'));
+
+  ASSERT_EQ(frames.size(), 2u);
+  EXPECT_EQ(frames[0], std::string("\x11\x00\x22", 3));
+  EXPECT_EQ(frames[1], std::string(254, 'z'));
+  EXPECT_EQ(decoder->getStats().errors, 1u);
+}
+
+TEST(FrameDecoderTest, OversizedFramesAreDropped) {
+  Frames frames;
+  auto decoder = makeDecoder(FramingMode::LINE, frames, 8);
+  feed(*decoder, "0123456");
+  feed(*decoder, "789abc\nshort\n");
+
+  EXPECT_EQ(frames, (Frames{"short"}));
+  EXPECT_EQ(decoder->getStats().oversized, 1u);
+}
+
+TEST(FrameDecoderTest, DecodesUartTraffic) {
+  ASSERT_TRUE(UART::initialize(3, 115200));
+  Frames rxFrames;
+  Frames txFrames;
+  auto rx = std::shared_ptr<FrameDecoder>(
+      makeDecoder(FramingMode::LINE, rxFrames));
+  auto tx = std::shared_ptr<FrameDecoder>(
+      makeDecoder(FramingMode::LINE, txFrames));
+  EXPECT_TRUE(UART::setDecoder(3, UARTDirection::RX, rx));
+  EXPECT_TRUE(UART::setDecoder(3, UARTDirection::TX, tx));
+
+  const std::string command = "AT\r\n";
+  UART::injectRx(3, reinterpret_cast<const uint8_t *>(command.data()),
+                 command.size());
+  const std::string reply = "OK\r\n";
+  UART::writeBuffer(3, reinterpret_cast<const uint8_t *>(reply.data()),
+                    reply.size());
+
+  EXPECT_EQ(rxFrames, (Frames{"AT"}));
+  EXPECT_EQ(txFrames, (Frames{"OK"}));
+
+  EXPECT_TRUE(UART::setDecoder(3, UARTDirection::RX, nullptr));
+  UART::injectRx(3, reinterpret_cast<const uint8_t *>(command.data()),
+                 command.size());
+  EXPECT_EQ(rxFrames.size(), 1u);
+
+  UART::setDecoder(3, UARTDirection::TX, nullptr);
+  UART::initialize(3, 115200);
+}
+
+TEST(FrameDecoderTest, PacedRxCallbackCanReply) {
+  ASSERT_TRUE(UART::initialize(3, 115200));
+  ASSERT_TRUE(UART::enableTiming(3));
+
+  // Echo every received line; on a paced channel writeBuffer wakes the TX
+  // timer, so this must not run on the timer thread
+  std::atomic<int> frames{0};
+  auto echo = std::make_shared<FrameDecoder>(
+      FramingMode::LINE, [&frames](const uint8_t *data, size_t size) {
+        UART::writeBuffer(3, data, size);
+        ++frames;
+      });
+  EXPECT_TRUE(UART::setDecoder(3, UARTDirection::RX, echo));
+
+  const std::string command = "AT\r\nATI\r\n";
+  UART::injectRx(3, reinterpret_cast<const uint8_t *>(command.data()),
+                 command.size());
+
+  std::string echoed;
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(5);
+  while (echoed.size() < 5 && std::chrono::steady_clock::now() < deadline) {
+    uint8_t buffer[16];
+    size_t n = UART::drainTx(3, buffer, sizeof(buffer));
+    echoed.append(reinterpret_cast<const char *>(buffer), n);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(frames, 2);
+  EXPECT_EQ(echoed, "ATATI");
+
+  UART::setDecoder(3, UARTDirection::RX, nullptr);
+  UART::disableTiming(3);
+  UART::initialize(3, 115200);
+}
\ No newline at end of file
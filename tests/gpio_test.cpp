@@ -1,5 +1,10 @@
 #include "sdk/gpio.hpp"
+#include "sdk/interrupt.hpp"
+#include <atomic>
+#include <chrono>
 #include <gtest/gtest.h>
+#include <thread>
+#include <vector>
 
 
 using namespace ti_sdk;
@@ -57,4 +62,167 @@ TEST_F(GPIOTest, SaveAndRestoreState) {
 
   EXPECT_TRUE(GPIO::restoreState(state));
   EXPECT_EQ(GPIO::readPin(1, 0), PinState::HIGH); // Restored state
+}
+
+TEST_F(GPIOTest, LayoutFromDeviceProfile) {
+  GPIOConfig config{4, 8, true, true, true};
+  EXPECT_TRUE(GPIO::initialize(config));
+  EXPECT_EQ(GPIO::getConfig().numPorts, 4);
+  EXPECT_EQ(GPIO::getConfig().pinsPerPort, 8);
+
+  EXPECT_TRUE(GPIO::configurePin(3, 7, PinMode::OUTPUT));
+  EXPECT_FALSE(GPIO::configurePin(4, 0, PinMode::OUTPUT)); // No such port
+  EXPECT_FALSE(GPIO::configurePin(0, 8, PinMode::OUTPUT)); // No such pin
+  EXPECT_FALSE(GPIO::writePin(0, 8, PinState::HIGH));
+
+  GPIOConfig invalid{4, 33, true, true, true};
+  EXPECT_FALSE(GPIO::initialize(invalid));
+}
+
+TEST_F(GPIOTest, ConcurrentWritesOnDifferentPorts) {
+  constexpr int kThreads = 4;
+  constexpr int kIterations = 10000;
+  for (uint8_t port = 0; port < kThreads; ++port) {
+    for (uint8_t pin = 0; pin < 8; ++pin) {
+      EXPECT_TRUE(GPIO::configurePin(port, pin, PinMode::OUTPUT));
+    }
+  }
+
+  std::vector<std::thread> threads;
+  for (uint8_t port = 0; port < kThreads; ++port) {
+    threads.emplace_back([port] {
+      for (int i = 0; i < kIterations; ++i) {
+        GPIO::togglePin(port, i % 8);
+      }
+    });
+  }
+  for (auto &t : threads) {
+    t.join();
+  }
+
+  // Every pin was toggled an even number of times
+  for (uint8_t port = 0; port < kThreads; ++port) {
+    for (uint8_t pin = 0; pin < 8; ++pin) {
+      EXPECT_EQ(GPIO::readPin(port, pin), PinState::LOW);
+    }
+  }
+}
+
+TEST_F(GPIOTest, PortMaskedOperations) {
+  for (uint8_t pin = 0; pin < 4; ++pin) {
+    EXPECT_TRUE(GPIO::configurePin(1, pin, PinMode::OUTPUT));
+  }
+  EXPECT_TRUE(GPIO::configurePin(1, 4, PinMode::INPUT));
+
+  EXPECT_TRUE(GPIO::setPins(1, 0b1001));
+  EXPECT_EQ(GPIO::readPort(1), 0b1001u);
+  EXPECT_EQ(GPIO::readPin(1, 3), PinState::HIGH);
+
+  EXPECT_TRUE(GPIO::togglePins(1, 0b0011));
+  EXPECT_EQ(GPIO::readPort(1), 0b1010u);
+
+  EXPECT_TRUE(GPIO::clearPins(1, 0b1000));
+  EXPECT_EQ(GPIO::readPort(1), 0b0010u);
+
+  EXPECT_TRUE(GPIO::writePortMasked(1, 0b0110, 0b1100));
+  EXPECT_EQ(GPIO::readPort(1), 0b0100u);
+}
+
+TEST_F(GPIOTest, PortMaskedRejectsNonOutputPins) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(1, 1, PinMode::INPUT));
+
+  EXPECT_FALSE(GPIO::setPins(1, 0b11));
+  EXPECT_FALSE(GPIO::writePortMasked(1, 0b11, 0b11));
+  EXPECT_EQ(GPIO::readPort(1), 0u); // Nothing was written
+}
+
+TEST_F(GPIOTest, EdgeFlagsLatchPerPin) {
+  EXPECT_TRUE(GPIO::configurePin(2, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(2, 1, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::enableInterrupt(2, 0, EdgeTrigger::RISING));
+  EXPECT_TRUE(GPIO::enableInterrupt(2, 1, EdgeTrigger::FALLING));
+
+  EXPECT_TRUE(GPIO::setPins(2, 0b11));
+  EXPECT_EQ(GPIO::getInterruptStatus(2), 0b01u); // Only pin 0 saw its edge
+
+  EXPECT_TRUE(GPIO::clearPins(2, 0b11));
+  EXPECT_EQ(GPIO::getInterruptStatus(2), 0b11u);
+
+  GPIO::clearInterruptFlags(2, 0b11);
+  EXPECT_EQ(GPIO::getInterruptStatus(2), 0u);
+
+  EXPECT_TRUE(GPIO::disableInterrupt(2, 0));
+  EXPECT_TRUE(GPIO::togglePin(2, 0));
+  EXPECT_EQ(GPIO::getInterruptStatus(2), 0u);
+}
+
+TEST_F(GPIOTest, EdgesRaiseInterrupts) {
+  std::atomic<int> rising{0};
+  std::atomic<int> change{0};
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::GPIO_RISING, 3,
+                             [&rising] { ++rising; });
+  interrupts.attachInterrupt(InterruptType::GPIO_CHANGE, 4,
+                             [&change] { ++change; });
+  interrupts.start();
+
+  EXPECT_TRUE(GPIO::configurePin(3, 5, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(4, 5, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::enableInterrupt(3, 5, EdgeTrigger::RISING));
+  EXPECT_TRUE(GPIO::enableInterrupt(4, 5, EdgeTrigger::BOTH));
+
+  EXPECT_TRUE(GPIO::writePin(3, 5, PinState::HIGH));
+  EXPECT_TRUE(GPIO::writePin(3, 5, PinState::LOW)); // Not a rising edge
+  EXPECT_TRUE(GPIO::togglePin(4, 5));
+  // Let the first edge dispatch so the second does not coalesce with it
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (change < 1 && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_TRUE(GPIO::togglePin(4, 5));
+
+  while ((rising < 1 || change < 2) &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  interrupts.stop();
+  interrupts.detachInterrupt(InterruptType::GPIO_RISING, 3);
+  interrupts.detachInterrupt(InterruptType::GPIO_CHANGE, 4);
+
+  EXPECT_EQ(rising, 1);
+  EXPECT_EQ(change, 2);
+}
+
+TEST_F(GPIOTest, RestoreStateRaisesEdges) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::enableInterrupt(1, 0, EdgeTrigger::RISING));
+  EXPECT_TRUE(GPIO::writePin(1, 0, PinState::HIGH));
+  std::string state = GPIO::saveState();
+
+  EXPECT_TRUE(GPIO::writePin(1, 0, PinState::LOW));
+  GPIO::clearInterruptFlags(1, 0b1);
+
+  EXPECT_TRUE(GPIO::restoreState(state));
+  EXPECT_EQ(GPIO::getInterruptStatus(1), 0b1u);
+}
+
+TEST_F(GPIOTest, DriveAndReleaseInputs) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::INPUT_PULLUP));
+  EXPECT_TRUE(GPIO::configurePin(1, 1, PinMode::INPUT_PULLDOWN));
+  EXPECT_TRUE(GPIO::configurePin(1, 2, PinMode::OUTPUT));
+  EXPECT_EQ(GPIO::readPort(1), 0b001u); // Idle at pull levels
+
+  EXPECT_TRUE(GPIO::driveInputs(1, 0b011, 0b010));
+  EXPECT_EQ(GPIO::readPort(1), 0b010u);
+  EXPECT_FALSE(GPIO::driveInputs(1, 0b100, 0b100)); // Not an input
+
+  EXPECT_TRUE(GPIO::releaseInputs(1, 0b011));
+  EXPECT_EQ(GPIO::readPort(1), 0b001u);
+}
+
+TEST_F(GPIOTest, PullUpRequiresHardwareSupport) {
+  GPIOConfig config{2, 8, true, false, true};
+  EXPECT_TRUE(GPIO::initialize(config));
+  EXPECT_FALSE(GPIO::configurePin(1, 0, PinMode::INPUT_PULLUP));
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::INPUT_PULLDOWN));
 }
\ No newline at end of file
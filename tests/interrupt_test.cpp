@@ -0,0 +1,405 @@
+#include "sdk/interrupt.hpp"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <memory>
+#include <mutex>
+#include <numeric>
+#include <thread>
+#include <vector>
+
+
+using namespace ti_sdk;
+using Clock = std::chrono::steady_clock;
+
+class InterruptTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    auto &interrupts = InterruptManager::getInstance();
+    interrupts.resetLatencyStats();
+    interrupts.resetCounters();
+    interrupts.start();
+  }
+
+  void TearDown() override {
+    auto &interrupts = InterruptManager::getInstance();
+    interrupts.stop();
+    interrupts.setWorkerCount(1);
+    interrupts.setGlobalMask(false);
+    for (uint8_t source = 0; source < 3; ++source) {
+      interrupts.detachInterrupt(InterruptType::TIMER, source);
+      interrupts.setPriority(InterruptType::TIMER, source, 0);
+      interrupts.setRateLimit(InterruptType::TIMER, source, 0);
+    }
+  }
+
+  // Wait until count reaches target or a timeout passed
+  static void waitFor(const std::atomic<int> &count, int target) {
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (count < target && Clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+
+  // Handler that appends its tag to order
+  InterruptManager::InterruptHandler record(int tag) {
+    return [this, tag] {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order.push_back(tag);
+      ++handled;
+    };
+  }
+
+  std::mutex orderMutex;
+  std::vector<int> order;
+  std::atomic<int> handled{0};
+};
+
+TEST_F(InterruptTest, DrainsBurstsWithoutPolling) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, [&] { ++handled; });
+
+  // Triggers of a pending line coalesce, so a burst is dispatched at most
+  // once per trigger and at least once after the last one
+  constexpr int kInterrupts = 20000;
+  auto start = Clock::now();
+  for (int i = 0; i < kInterrupts; ++i)
+    interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  auto deadline = Clock::now() + std::chrono::seconds(5);
+  while (interrupts.isPending(InterruptType::TIMER, 0) &&
+         Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_GE(handled, 1);
+  EXPECT_LE(handled, kInterrupts);
+  EXPECT_LT(Clock::now() - start, std::chrono::seconds(2));
+
+  auto stats = interrupts.getLatencyStats();
+  EXPECT_EQ(stats.count, static_cast<uint64_t>(handled));
+  EXPECT_EQ(std::accumulate(stats.histogram.begin(), stats.histogram.end(),
+                            static_cast<uint64_t>(0)),
+            stats.count);
+  EXPECT_GE(stats.maxNs, stats.totalNs / stats.count);
+}
+
+TEST_F(InterruptTest, SingleInterruptIsDeliveredPromptly) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, [&] { ++handled; });
+
+  for (int i = 1; i <= 20; ++i) {
+    interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+    waitFor(handled, i);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(handled, 20);
+
+  // The dispatcher wakes on the trigger instead of after a 1 ms sleep, so
+  // typical latency is far below a millisecond even on a loaded machine
+  auto stats = interrupts.getLatencyStats();
+  ASSERT_EQ(stats.count, 20u);
+  EXPECT_LT(stats.totalNs / stats.count, 500000u);
+
+  // Triggers without a handler are ignored
+  interrupts.triggerInterrupt(InterruptType::TIMER, 2);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(interrupts.getLatencyStats().count, 20u);
+}
+
+TEST_F(InterruptTest, HigherPriorityDispatchesFirst) {
+  auto &interrupts = InterruptManager::getInstance();
+  EXPECT_FALSE(interrupts.setPriority(InterruptType::TIMER, 0,
+                                      InterruptManager::kPriorityLevels));
+  ASSERT_TRUE(interrupts.setPriority(InterruptType::TIMER, 0, 5));
+  ASSERT_TRUE(interrupts.setPriority(InterruptType::TIMER, 1, 2));
+  EXPECT_EQ(interrupts.getPriority(InterruptType::TIMER, 0), 5);
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, record(1));
+  interrupts.attachInterrupt(InterruptType::TIMER, 2, record(2));
+
+  interrupts.setGlobalMask(true);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 2);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+  // Reprioritizing moves a pending interrupt along
+  ASSERT_TRUE(interrupts.setPriority(InterruptType::TIMER, 2, 7));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(handled, 0);
+
+  interrupts.setGlobalMask(false);
+  waitFor(handled, 3);
+  std::lock_guard<std::mutex> lock(orderMutex);
+  EXPECT_EQ(order, (std::vector<int>{1, 0, 2}));
+}
+
+TEST_F(InterruptTest, CoalescesRetriggeredPendingInterrupt) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+
+  interrupts.setGlobalMask(true);
+  for (int i = 0; i < 5; ++i)
+    interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  EXPECT_TRUE(interrupts.isPending(InterruptType::TIMER, 0));
+
+  interrupts.setGlobalMask(false);
+  waitFor(handled, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(handled, 1);
+  EXPECT_FALSE(interrupts.isPending(InterruptType::TIMER, 0));
+}
+
+TEST_F(InterruptTest, DisabledSourceLatchesUntilEnabled) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, record(1));
+  EXPECT_TRUE(interrupts.isEnabled(InterruptType::TIMER, 0));
+
+  interrupts.disableInterrupt(InterruptType::TIMER, 0);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  // Other sources keep running
+  interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+  waitFor(handled, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(handled, 1);
+  EXPECT_TRUE(interrupts.isPending(InterruptType::TIMER, 0));
+
+  interrupts.enableInterrupt(InterruptType::TIMER, 0);
+  waitFor(handled, 2);
+  EXPECT_EQ(handled, 2);
+
+  // A cleared interrupt is not dispatched on enable
+  interrupts.disableInterrupt(InterruptType::TIMER, 0);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  interrupts.clearPending(InterruptType::TIMER, 0);
+  interrupts.enableInterrupt(InterruptType::TIMER, 0);
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(handled, 2);
+}
+
+TEST_F(InterruptTest, UrgentInterruptPreemptsRunningHandler) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.setPriority(InterruptType::TIMER, 0, 4);
+  interrupts.setPriority(InterruptType::TIMER, 1, 0);
+  interrupts.setPriority(InterruptType::TIMER, 2, 6);
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, record(1));
+  interrupts.attachInterrupt(InterruptType::TIMER, 2, record(2));
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, [&] {
+    {
+      std::lock_guard<std::mutex> lock(orderMutex);
+      order.push_back(0);
+    }
+    // The urgent line runs before this handler returns, the less urgent
+    // one after it
+    interrupts.triggerInterrupt(InterruptType::TIMER, 2);
+    interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+    std::lock_guard<std::mutex> lock(orderMutex);
+    order.push_back(-1);
+    ++handled;
+  });
+
+  interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  waitFor(handled, 3);
+  std::lock_guard<std::mutex> lock(orderMutex);
+  EXPECT_EQ(order, (std::vector<int>{0, 1, -1, 2}));
+}
+
+TEST_F(InterruptTest, InlineHandlerCopiesCapturedState) {
+  int calls = 0;
+  auto shared = std::make_shared<int>(0);
+  InlineHandler handler = [&calls, shared] {
+    ++calls;
+    ++*shared;
+  };
+  EXPECT_EQ(shared.use_count(), 2);
+  {
+    InlineHandler copy = handler;
+    EXPECT_EQ(shared.use_count(), 3);
+    copy();
+  }
+  EXPECT_EQ(shared.use_count(), 2);
+  handler();
+  EXPECT_EQ(calls, 2);
+  EXPECT_EQ(*shared, 2);
+
+  handler = nullptr;
+  EXPECT_FALSE(handler);
+  EXPECT_EQ(shared.use_count(), 1);
+
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+  EXPECT_TRUE(interrupts.detachInterrupt(InterruptType::TIMER, 0));
+  EXPECT_FALSE(interrupts.detachInterrupt(InterruptType::TIMER, 0));
+}
+
+TEST_F(InterruptTest, RateLimitDropsStormAndSparesOtherSources) {
+  auto &interrupts = InterruptManager::getInstance();
+  EXPECT_FALSE(interrupts.setRateLimit(InterruptType::TIMER, 0, 100, 0));
+  ASSERT_TRUE(interrupts.setRateLimit(InterruptType::TIMER, 0, 100, 5));
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+  std::atomic<int> quiet{0};
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, [&quiet] { ++quiet; });
+
+  // Two producers flood one line for 200 ms
+  std::atomic<bool> flooding{true};
+  auto flood = [&] {
+    while (flooding)
+      interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  };
+  std::thread first(flood);
+  std::thread second(flood);
+  auto start = Clock::now();
+  std::this_thread::sleep_for(std::chrono::milliseconds(50));
+  interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+  waitFor(quiet, 1);
+  EXPECT_EQ(quiet, 1);
+  std::this_thread::sleep_for(std::chrono::milliseconds(150));
+  flooding = false;
+  first.join();
+  second.join();
+  auto elapsed = Clock::now() - start;
+
+  auto deadline = Clock::now() + std::chrono::seconds(5);
+  while (interrupts.isPending(InterruptType::TIMER, 0) &&
+         Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+
+  // A burst of 5 plus 100 per second, whatever the trigger rate
+  auto counters = interrupts.getCounters(InterruptType::TIMER, 0);
+  auto elapsedMs =
+      std::chrono::duration_cast<std::chrono::milliseconds>(elapsed).count();
+  EXPECT_GE(counters.dispatched, 1u);
+  EXPECT_LE(counters.dispatched, 5u + elapsedMs / 10);
+  EXPECT_EQ(counters.dispatched, static_cast<uint64_t>(handled));
+  EXPECT_GT(counters.dropped, 0u);
+  EXPECT_EQ(counters.triggered,
+            counters.coalesced + counters.dropped + counters.dispatched);
+
+  auto total = interrupts.getCounters();
+  EXPECT_EQ(total.triggered, counters.triggered + 1);
+  EXPECT_EQ(total.dispatched, counters.dispatched + 1);
+}
+
+TEST_F(InterruptTest, CountsCoalescedTriggers) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, record(0));
+  interrupts.setGlobalMask(true);
+  for (int i = 0; i < 10; ++i)
+    interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  // Lines without a handler are not counted
+  interrupts.triggerInterrupt(InterruptType::TIMER, 2);
+  interrupts.setGlobalMask(false);
+  waitFor(handled, 1);
+
+  auto counters = interrupts.getCounters();
+  EXPECT_EQ(counters.triggered, 10u);
+  EXPECT_EQ(counters.coalesced, 9u);
+  EXPECT_EQ(counters.dropped, 0u);
+  EXPECT_EQ(counters.dispatched, 1u);
+
+  interrupts.resetCounters();
+  EXPECT_EQ(interrupts.getCounters().triggered, 0u);
+}
+
+TEST_F(InterruptTest, WorkerCountChangesOnlyWhileStopped) {
+  auto &interrupts = InterruptManager::getInstance();
+  EXPECT_EQ(interrupts.getWorkerCount(), 1u);
+  EXPECT_FALSE(interrupts.setWorkerCount(4));
+  interrupts.stop();
+  EXPECT_FALSE(interrupts.setWorkerCount(0));
+  EXPECT_FALSE(interrupts.setWorkerCount(InterruptManager::kMaxWorkers + 1));
+  EXPECT_TRUE(interrupts.setWorkerCount(4));
+  EXPECT_EQ(interrupts.getWorkerCount(), 4u);
+
+  // Interrupts pending across a restart are dispatched by the new workers
+  interrupts.attachInterrupt(InterruptType::TIMER, 2, record(2));
+  interrupts.triggerInterrupt(InterruptType::TIMER, 2);
+  interrupts.start();
+  waitFor(handled, 1);
+  EXPECT_EQ(handled, 1);
+}
+
+TEST_F(InterruptTest, SlowHandlerDoesNotDelayOtherWorkers) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.stop();
+  ASSERT_TRUE(interrupts.setWorkerCount(2));
+  interrupts.start();
+
+  std::atomic<bool> release{false};
+  std::atomic<int> slow{0};
+  interrupts.attachInterrupt(InterruptType::TIMER, 0, [&] {
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (!release && Clock::now() < deadline)
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    ++slow;
+  });
+  interrupts.attachInterrupt(InterruptType::TIMER, 1, record(1));
+
+  // TIMER 0 and TIMER 1 land on different workers
+  interrupts.triggerInterrupt(InterruptType::TIMER, 0);
+  interrupts.triggerInterrupt(InterruptType::TIMER, 1);
+  waitFor(handled, 1);
+  EXPECT_EQ(handled, 1);
+  EXPECT_EQ(slow, 0);
+  release = true;
+  waitFor(slow, 1);
+  EXPECT_EQ(slow, 1);
+}
+
+TEST_F(InterruptTest, WorkersKeepEachLineSequential) {
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.stop();
+  ASSERT_TRUE(interrupts.setWorkerCount(3));
+  interrupts.start();
+
+  // Each handler checks that no line of its source is already running,
+  // lines of one source sharing a worker whatever their type
+  const InterruptType types[] = {InterruptType::TIMER,
+                                 InterruptType::GPIO_RISING,
+                                 InterruptType::GPIO_FALLING};
+  struct Tracker {
+    std::atomic<int> running[3] = {{0}, {0}, {0}};
+    std::atomic<int> active{0};
+    std::atomic<int> maxActive{0};
+    std::atomic<int> overlaps{0};
+    std::atomic<int> *handled;
+  } tracker;
+  tracker.handled = &handled;
+  for (InterruptType type : types) {
+    for (uint8_t source = 0; source < 3; ++source) {
+      auto *t = &tracker;
+      interrupts.attachInterrupt(type, source, [t, source] {
+        if (t->running[source]++ != 0)
+          ++t->overlaps;
+        int now = ++t->active;
+        int max = t->maxActive;
+        while (now > max && !t->maxActive.compare_exchange_weak(max, now)) {
+        }
+        std::this_thread::sleep_for(std::chrono::microseconds(200));
+        --t->active;
+        --t->running[source];
+        ++*t->handled;
+      });
+    }
+  }
+
+  std::atomic<bool> flooding{true};
+  auto flood = [&] {
+    for (int i = 0; flooding; ++i)
+      interrupts.triggerInterrupt(types[i / 3 % 3], i % 3);
+  };
+  std::thread first(flood);
+  std::thread second(flood);
+  waitFor(handled, 300);
+  flooding = false;
+  first.join();
+  second.join();
+  // Handlers still running refer to tracker
+  interrupts.stop();
+  for (uint8_t source = 0; source < 3; ++source) {
+    interrupts.detachInterrupt(InterruptType::GPIO_RISING, source);
+    interrupts.detachInterrupt(InterruptType::GPIO_FALLING, source);
+  }
+
+  EXPECT_GE(handled, 300);
+  EXPECT_EQ(tracker.overlaps, 0);
+  EXPECT_GT(tracker.maxActive, 1);
+}
\ No newline at end of file
@@ -0,0 +1,66 @@
+#include "sdk/scheduler.hpp"
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+
+using namespace ti_sdk;
+
+namespace {
+struct Ticker {
+  std::atomic<int> ticks{0};
+  int limit = 0;
+  uint64_t periodNs = 0;
+  uint64_t firstDeadlineNs = 0;
+  uint64_t lastDeadlineNs = 0;
+};
+
+uint64_t tick(void *context, uint64_t deadlineNs, uint64_t) {
+  auto &ticker = *static_cast<Ticker *>(context);
+  if (ticker.ticks == 0)
+    ticker.firstDeadlineNs = deadlineNs;
+  ticker.lastDeadlineNs = deadlineNs;
+  if (++ticker.ticks >= ticker.limit)
+    return 0;
+  return deadlineNs + ticker.periodNs;
+}
+
+bool waitForTicks(const Ticker &ticker, int ticks) {
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (ticker.ticks < ticks && std::chrono::steady_clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  return ticker.ticks >= ticks;
+}
+} // namespace
+
+TEST(SchedulerTest, PeriodicTimerFollowsAbsoluteDeadlines) {
+  Ticker ticker;
+  ticker.limit = 5;
+  ticker.periodNs = 1000000;
+  uint32_t timer = TimerScheduler::add(tick, &ticker);
+  TimerScheduler::wake(timer, TimerScheduler::nowNs() + 1000000);
+
+  EXPECT_TRUE(waitForTicks(ticker, 5));
+  std::this_thread::sleep_for(std::chrono::milliseconds(5));
+  EXPECT_EQ(ticker.ticks, 5); // Idle after returning 0
+  EXPECT_EQ(ticker.lastDeadlineNs - ticker.firstDeadlineNs, 4000000u);
+
+  // An idle timer runs again when woken
+  ticker.limit = 6;
+  TimerScheduler::wake(timer, TimerScheduler::nowNs());
+  EXPECT_TRUE(waitForTicks(ticker, 6));
+  TimerScheduler::remove(timer);
+}
+
+TEST(SchedulerTest, RemovedTimerNeverRuns) {
+  Ticker ticker;
+  ticker.limit = 1;
+  uint32_t timer = TimerScheduler::add(tick, &ticker);
+  TimerScheduler::wake(timer, TimerScheduler::nowNs() + 20000000);
+  TimerScheduler::remove(timer);
+  TimerScheduler::wake(timer, TimerScheduler::nowNs()); // Ignored
+
+  std::this_thread::sleep_for(std::chrono::milliseconds(30));
+  EXPECT_EQ(ticker.ticks, 0);
+}
\ No newline at end of file
@@ -0,0 +1,82 @@
+#include "sdk/gpio.hpp"
+#include "sdk/stimulus.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+
+
+using namespace ti_sdk;
+
+class StimulusTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    GPIO::initialize();
+    filename_ = ::testing::TempDir() + "stimulus_test.dat";
+  }
+
+  void TearDown() override {
+    StimulusPlayer::stop();
+    std::remove(filename_.c_str());
+    GPIO::initialize();
+  }
+
+  static void waitForReplay() {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (StimulusPlayer::isRunning() &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::sleep_for(std::chrono::milliseconds(1));
+    }
+  }
+
+  std::string filename_;
+};
+
+TEST_F(StimulusTest, ReplaysBinaryRecords) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::INPUT));
+  EXPECT_TRUE(GPIO::configurePin(1, 1, PinMode::INPUT));
+  EXPECT_TRUE(GPIO::configurePin(2, 0, PinMode::OUTPUT));
+
+  {
+    std::ofstream file(filename_, std::ios::binary);
+    file.write(kStimulusMagic, sizeof(kStimulusMagic));
+    StimulusRecord records[] = {{0, 0b11, 0b01, 1, {}},
+                                {1000, 0b10, 0b10, 1, {}},
+                                {2000, 0b01, 0b01, 2, {}}}; // Output pin
+    file.write(reinterpret_cast<const char *>(records), sizeof(records));
+  }
+
+  EXPECT_TRUE(StimulusPlayer::start(filename_, true));
+  waitForReplay();
+
+  EXPECT_EQ(GPIO::readPort(1), 0b11u);
+  EXPECT_EQ(GPIO::readPort(2), 0u);
+  auto stats = StimulusPlayer::getStats();
+  EXPECT_EQ(stats.records, 2u);
+  EXPECT_EQ(stats.rejected, 1u);
+}
+
+TEST_F(StimulusTest, ReplaysVcdTrace) {
+  EXPECT_TRUE(GPIO::configurePin(3, 4, PinMode::INPUT_PULLUP));
+  EXPECT_TRUE(GPIO::configurePin(3, 5, PinMode::INPUT));
+
+  {
+    std::ofstream file(filename_);
+    file << "$timescale 1 us $end\n"
+            "$scope module gpio $end\n"
+            "$var wire 1 ! P3_4 $end\n"
+            "$var wire 1 \" P3_5 $end\n"
+            "$upscope $end\n$enddefinitions $end\n"
+            "#0\n$dumpvars\n0!\n0\"\n$end\n"
+            "#10\n1\"\n"
+            "#20\nz!\n";
+  }
+
+  EXPECT_TRUE(StimulusPlayer::start(filename_));
+  waitForReplay();
+
+  EXPECT_EQ(GPIO::readPin(3, 5), PinState::HIGH);
+  EXPECT_EQ(GPIO::readPin(3, 4), PinState::HIGH); // Released to pull-up
+  EXPECT_EQ(StimulusPlayer::getStats().records, 3u);
+}
\ No newline at end of file
@@ -0,0 +1,187 @@
+#include "sdk/uart.hpp"
+#include "sdk/uart_pty_bridge.hpp"
+#include "sdk/uart_replay.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fcntl.h>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <poll.h>
+#include <thread>
+#include <unistd.h>
+#include <vector>
+
+
+using namespace ti_sdk;
+using Clock = std::chrono::steady_clock;
+
+class UARTPtyBridgeTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    ASSERT_TRUE(UART::initialize(1, 115200));
+    ASSERT_TRUE(UARTPtyBridge::open(1, path_));
+    client_ = ::open(path_.c_str(), O_RDWR | O_NOCTTY | O_NONBLOCK);
+    ASSERT_GE(client_, 0);
+  }
+
+  void TearDown() override {
+    if (client_ >= 0)
+      ::close(client_);
+    UARTPtyBridge::closeAll();
+    UART::initialize(1, 115200);
+  }
+
+  // Read from the terminal until count bytes arrived or a timeout passed
+  std::vector<uint8_t> readClient(size_t count) {
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (data.size() < count && Clock::now() < deadline) {
+      pollfd fd{client_, POLLIN, 0};
+      if (poll(&fd, 1, 10) <= 0)
+        continue;
+      ssize_t n = ::read(client_, buffer, sizeof(buffer));
+      if (n > 0)
+        data.insert(data.end(), buffer, buffer + n);
+    }
+    return data;
+  }
+
+  std::string path_;
+  int client_ = -1;
+};
+
+TEST_F(UARTPtyBridgeTest, BytesFlowBothWays) {
+  EXPECT_EQ(UARTPtyBridge::getPath(1), path_);
+  EXPECT_EQ(path_.rfind("/dev/pts/", 0), 0u);
+  std::string dummy;
+  EXPECT_FALSE(UARTPtyBridge::open(1, dummy)); // Already bridged
+
+  const char request[] = "AT\r\n";
+  ASSERT_EQ(::write(client_, request, 4), 4);
+  std::vector<uint8_t> received;
+  auto deadline = Clock::now() + std::chrono::seconds(5);
+  uint8_t buffer[16];
+  while (received.size() < 4 && Clock::now() < deadline) {
+    size_t n = UART::readBuffer(1, buffer, sizeof(buffer));
+    received.insert(received.end(), buffer, buffer + n);
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_EQ(std::string(received.begin(), received.end()), "AT\r\n");
+
+  const uint8_t reply[] = {'O', 'K', '\r', '\n'}; // Raw mode keeps \r\n
+  EXPECT_EQ(UART::writeBuffer(1, reply, sizeof(reply)), 4u);
+  auto data = readClient(4);
+  EXPECT_EQ(std::string(data.begin(), data.end()), "OK\r\n");
+
+  auto stats = UARTPtyBridge::getStats(1);
+  EXPECT_EQ(stats.bytesIn, 4u);
+  EXPECT_EQ(stats.bytesOut, 4u);
+}
+
+TEST_F(UARTPtyBridgeTest, BulkTransmitWithoutLoss) {
+  constexpr size_t kBytes = 1 << 20;
+  std::thread firmware([] {
+    std::vector<uint8_t> chunk(4096);
+    size_t sent = 0;
+    while (sent < kBytes) {
+      size_t length = std::min(chunk.size(), kBytes - sent);
+      for (size_t i = 0; i < length; ++i)
+        chunk[i] = static_cast<uint8_t>((sent + i) * 7);
+      size_t n = UART::writeBuffer(1, chunk.data(), length);
+      if (n < length)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      sent += n;
+    }
+  });
+
+  auto data = readClient(kBytes);
+  firmware.join();
+
+  ASSERT_EQ(data.size(), kBytes);
+  bool ordered = true;
+  for (size_t i = 0; i < kBytes; ++i)
+    ordered &= data[i] == static_cast<uint8_t>(i * 7);
+  EXPECT_TRUE(ordered);
+}
+
+TEST_F(UARTPtyBridgeTest, ReplayCannotShareTheReceiver) {
+  // Larger than the RX buffer, so the replay keeps running while unread
+  std::string filename = ::testing::TempDir() + "uart_pty_bridge_test.dat";
+  {
+    std::vector<char> data(1 << 20, 'x');
+    std::ofstream file(filename, std::ios::binary);
+    file.write(data.data(), data.size());
+  }
+
+  EXPECT_FALSE(UARTReplay::start(1, filename));
+  ASSERT_TRUE(UARTPtyBridge::close(1));
+  ASSERT_TRUE(UARTReplay::start(1, filename));
+  std::string path;
+  EXPECT_FALSE(UARTPtyBridge::open(1, path));
+  UARTReplay::stop(1);
+  EXPECT_TRUE(UARTPtyBridge::open(1, path));
+
+  std::remove(filename.c_str());
+}
+
+TEST_F(UARTPtyBridgeTest, BulkReceiveWithoutLoss) {
+  // 16x the RX buffer: the bridge has to wait for the firmware to make
+  // room, and is only woken by the UART when it does
+  constexpr size_t kBytes = 1 << 20;
+  std::thread host([this] {
+    std::vector<uint8_t> data(kBytes);
+    for (size_t i = 0; i < kBytes; ++i)
+      data[i] = static_cast<uint8_t>(i * 11);
+    size_t sent = 0;
+    auto deadline = Clock::now() + std::chrono::seconds(10);
+    while (sent < kBytes && Clock::now() < deadline) {
+      pollfd fd{client_, POLLOUT, 0};
+      if (poll(&fd, 1, 10) <= 0)
+        continue;
+      ssize_t n = ::write(client_, data.data() + sent, kBytes - sent);
+      if (n > 0)
+        sent += static_cast<size_t>(n);
+    }
+  });
+
+  std::vector<uint8_t> received;
+  uint8_t buffer[4096];
+  auto deadline = Clock::now() + std::chrono::seconds(10);
+  while (received.size() < kBytes && Clock::now() < deadline) {
+    size_t n = UART::readBuffer(1, buffer, sizeof(buffer));
+    if (n == 0)
+      std::this_thread::sleep_for(std::chrono::microseconds(100));
+    received.insert(received.end(), buffer, buffer + n);
+  }
+  host.join();
+
+  ASSERT_EQ(received.size(), kBytes);
+  bool ordered = true;
+  for (size_t i = 0; i < kBytes; ++i)
+    ordered &= received[i] == static_cast<uint8_t>(i * 11);
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(UART::getStats(1).rxOverflows, 0u);
+}
+
+TEST_F(UARTPtyBridgeTest, SingleBytesAfterIdleArrive) {
+  // Every byte is written after the bridge has drained TX dry and gone to
+  // sleep, so each one needs a notification
+  for (int i = 0; i < 200; ++i) {
+    uint8_t byte = static_cast<uint8_t>(i);
+    ASSERT_EQ(UART::writeBuffer(1, &byte, 1), 1u);
+    auto data = readClient(1);
+    ASSERT_EQ(data.size(), 1u);
+    EXPECT_EQ(data[0], byte);
+  }
+}
+
+TEST_F(UARTPtyBridgeTest, TxHasOneConsumer) {
+  EXPECT_FALSE(UART::claimTx(1)); // held by the bridge
+  ASSERT_TRUE(UARTPtyBridge::close(1));
+  EXPECT_TRUE(UART::claimTx(1));
+  std::string path;
+  EXPECT_FALSE(UARTPtyBridge::open(1, path));
+  UART::releaseTx(1);
+  EXPECT_TRUE(UARTPtyBridge::open(1, path));
+}
\ No newline at end of file
@@ -0,0 +1,93 @@
+#include "sdk/uart.hpp"
+#include "sdk/uart_replay.hpp"
+#include <chrono>
+#include <cstdio>
+#include <fstream>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+
+using namespace ti_sdk;
+using Clock = std::chrono::steady_clock;
+
+class UARTReplayTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    UART::initialize(2, 115200);
+    filename_ = ::testing::TempDir() + "uart_replay_test.dat";
+  }
+
+  void TearDown() override {
+    UARTReplay::stop(2);
+    std::remove(filename_.c_str());
+    UART::initialize(2, 115200);
+  }
+
+  // Read from RX until count bytes arrived or a timeout passed
+  static std::vector<uint8_t> readRx(size_t count) {
+    std::vector<uint8_t> data;
+    uint8_t buffer[4096];
+    auto deadline = Clock::now() + std::chrono::seconds(5);
+    while (data.size() < count && Clock::now() < deadline) {
+      size_t n = UART::readBuffer(2, buffer, sizeof(buffer));
+      if (n == 0)
+        std::this_thread::sleep_for(std::chrono::microseconds(100));
+      data.insert(data.end(), buffer, buffer + n);
+    }
+    return data;
+  }
+
+  std::string filename_;
+};
+
+TEST_F(UARTReplayTest, RawCaptureLargerThanRxBuffer) {
+  constexpr size_t kBytes = 1 << 20; // 16x the RX buffer
+  {
+    std::vector<char> data(kBytes);
+    for (size_t i = 0; i < kBytes; ++i)
+      data[i] = static_cast<char>(i * 13);
+    std::ofstream file(filename_, std::ios::binary);
+    file.write(data.data(), data.size());
+  }
+
+  ASSERT_TRUE(UARTReplay::start(2, filename_));
+  auto data = readRx(kBytes);
+
+  ASSERT_EQ(data.size(), kBytes);
+  bool ordered = true;
+  for (size_t i = 0; i < kBytes; ++i)
+    ordered &= data[i] == static_cast<uint8_t>(i * 13);
+  EXPECT_TRUE(ordered);
+  EXPECT_EQ(UART::getStats(2).rxOverflows, 0u);
+  EXPECT_EQ(UARTReplay::getStats(2).bytes, kBytes);
+  EXPECT_GT(UARTReplay::getStats(2).stalls, 0u);
+}
+
+TEST_F(UARTReplayTest, TimestampedCaptureAtRecordedTiming) {
+  {
+    std::ofstream file(filename_, std::ios::binary);
+    file.write(kUartCaptureMagic, sizeof(kUartCaptureMagic));
+    UARTCaptureRecord first{0, 3, 0};
+    file.write(reinterpret_cast<const char *>(&first), sizeof(first));
+    file.write("AT\r", 3);
+    UARTCaptureRecord second{20000000, 4, 0}; // 20 ms later
+    file.write(reinterpret_cast<const char *>(&second), sizeof(second));
+    file.write("OK\r\n", 4);
+  }
+
+  auto start = Clock::now();
+  ASSERT_TRUE(UARTReplay::start(2, filename_, true));
+  EXPECT_FALSE(UARTReplay::start(2, filename_)); // Already running
+  auto first = readRx(3);
+  EXPECT_EQ(std::string(first.begin(), first.end()), "AT\r");
+  auto second = readRx(4);
+  EXPECT_EQ(std::string(second.begin(), second.end()), "OK\r\n");
+  EXPECT_GE(Clock::now() - start, std::chrono::milliseconds(20));
+
+  auto deadline = Clock::now() + std::chrono::seconds(2);
+  while (UARTReplay::isRunning(2) && Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_FALSE(UARTReplay::isRunning(2));
+  EXPECT_EQ(UARTReplay::getStats(2).records, 2u);
+}
\ No newline at end of file
@@ -0,0 +1,327 @@
+#include "sdk/interrupt.hpp"
+#include "sdk/uart.hpp"
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+#include <vector>
+
+
+using namespace ti_sdk;
+using Clock = std::chrono::steady_clock;
+
+// Drain a paced channel until count bytes went out or the timeout passed
+size_t drainFor(uint8_t channel, size_t count, Clock::duration timeout) {
+  auto deadline = Clock::now() + timeout;
+  uint8_t buffer[64];
+  size_t drained = 0;
+  while (drained < count && Clock::now() < deadline) {
+    drained += UART::drainTx(channel, buffer, sizeof(buffer));
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  return drained;
+}
+
+class UARTTest : public ::testing::Test {
+protected:
+  void SetUp() override {
+    UARTConfig config = UART::getConfig();
+    config.txBufferSize = 16;
+    config.rxBufferSize = 16;
+    UART::configure(config);
+    for (uint8_t ch = 0; ch < config.numChannels; ++ch)
+      UART::initialize(ch, 115200);
+  }
+
+  void TearDown() override {
+    UARTConfig config = UART::getConfig();
+    config.txBufferSize = 64 * 1024;
+    config.rxBufferSize = 64 * 1024;
+    UART::configure(config);
+    for (uint8_t ch = 0; ch < config.numChannels; ++ch)
+      UART::initialize(ch, 115200);
+  }
+};
+
+TEST_F(UARTTest, RejectsUnsupportedBaudRate) {
+  EXPECT_FALSE(UART::initialize(12345));
+  EXPECT_TRUE(UART::initialize(9600));
+}
+
+TEST_F(UARTTest, WriteAndDrainTx) {
+  EXPECT_TRUE(UART::write(0x55));
+  const uint8_t data[] = {1, 2, 3};
+  EXPECT_EQ(UART::writeBuffer(data, sizeof(data)), 3u);
+
+  uint8_t out[8];
+  EXPECT_EQ(UART::drainTx(out, sizeof(out)), 4u);
+  EXPECT_EQ(out[0], 0x55);
+  EXPECT_EQ(out[3], 3);
+  EXPECT_EQ(UART::drainTx(out, sizeof(out)), 0u);
+}
+
+TEST_F(UARTTest, InjectAndReadRx) {
+  EXPECT_FALSE(UART::available());
+  const uint8_t data[] = {'O', 'K', '\r', '\n'};
+  EXPECT_EQ(UART::injectRx(data, sizeof(data)), 4u);
+  EXPECT_TRUE(UART::available());
+
+  uint8_t byte;
+  EXPECT_TRUE(UART::read(byte));
+  EXPECT_EQ(byte, 'O');
+
+  uint8_t out[8];
+  EXPECT_EQ(UART::readBuffer(out, sizeof(out)), 3u);
+  EXPECT_EQ(out[2], '\n');
+  EXPECT_FALSE(UART::read(byte));
+}
+
+TEST_F(UARTTest, OverflowIsCounted) {
+  std::vector<uint8_t> data(20, 0xAA);
+  EXPECT_EQ(UART::writeBuffer(data.data(), data.size()), 16u);
+  EXPECT_FALSE(UART::write(0xAA));
+  EXPECT_EQ(UART::injectRx(data.data(), data.size()), 16u);
+
+  auto stats = UART::getStats();
+  EXPECT_EQ(stats.txPending, 16u);
+  EXPECT_EQ(stats.rxPending, 16u);
+  EXPECT_EQ(stats.txOverflows, 5u);
+  EXPECT_EQ(stats.rxOverflows, 4u);
+}
+
+TEST_F(UARTTest, ConcurrentProducerAndConsumer) {
+  constexpr size_t kBytes = 1 << 20;
+  std::thread producer([] {
+    std::vector<uint8_t> chunk(7);
+    size_t sent = 0;
+    while (sent < kBytes) {
+      size_t length = std::min(chunk.size(), kBytes - sent);
+      for (size_t i = 0; i < length; ++i)
+        chunk[i] = static_cast<uint8_t>(sent + i);
+      size_t n = UART::injectRx(chunk.data(), length);
+      if (n == 0)
+        std::this_thread::yield();
+      sent += n;
+    }
+  });
+
+  size_t received = 0;
+  bool ordered = true;
+  uint8_t buffer[5];
+  while (received < kBytes) {
+    size_t n = UART::readBuffer(buffer, sizeof(buffer));
+    if (n == 0)
+      std::this_thread::yield();
+    for (size_t i = 0; i < n; ++i)
+      ordered &= buffer[i] == static_cast<uint8_t>(received + i);
+    received += n;
+  }
+  producer.join();
+
+  EXPECT_TRUE(ordered);
+}
+
+TEST_F(UARTTest, SaveAndRestoreState) {
+  const uint8_t rx[] = {1, 2, 3};
+  const uint8_t tx[] = {4, 5};
+  UART::injectRx(rx, sizeof(rx));
+  UART::writeBuffer(tx, sizeof(tx));
+
+  std::string state = UART::saveState();
+  EXPECT_TRUE(UART::initialize(115200)); // Reset buffers
+  EXPECT_FALSE(UART::available());
+
+  EXPECT_TRUE(UART::restoreState(state));
+  auto stats = UART::getStats();
+  EXPECT_EQ(stats.rxPending, 3u);
+  EXPECT_EQ(stats.txPending, 2u);
+
+  uint8_t out[4];
+  EXPECT_EQ(UART::readBuffer(out, sizeof(out)), 3u);
+  EXPECT_EQ(out[2], 3);
+}
+
+TEST_F(UARTTest, ChannelCountFromConfig) {
+  UARTConfig config = UART::getConfig();
+  config.numChannels = 2;
+  UART::configure(config);
+
+  EXPECT_TRUE(UART::initialize(1, 115200));
+  EXPECT_FALSE(UART::initialize(2, 115200));
+  EXPECT_FALSE(UART::write(2, 0x55));
+  EXPECT_FALSE(UART::available(2));
+  EXPECT_TRUE(UART::saveState(2).empty());
+
+  config.numChannels = 4;
+  UART::configure(config);
+}
+
+TEST_F(UARTTest, ChannelsAreIndependent) {
+  const uint8_t data[] = {'A', 'B'};
+  EXPECT_EQ(UART::injectRx(1, data, sizeof(data)), 2u);
+  EXPECT_TRUE(UART::write(2, 'C'));
+  EXPECT_FALSE(UART::available(0));
+  EXPECT_TRUE(UART::available(1));
+  EXPECT_EQ(UART::getStats(2).txPending, 1u);
+
+  std::string state = UART::saveState(1);
+  EXPECT_TRUE(UART::initialize(1, 9600));
+  EXPECT_FALSE(UART::available(1));
+  EXPECT_TRUE(UART::restoreState(3, state));
+
+  uint8_t out[4];
+  EXPECT_EQ(UART::readBuffer(3, out, sizeof(out)), 2u);
+  EXPECT_EQ(out[1], 'B');
+  EXPECT_EQ(UART::drainTx(2, out, sizeof(out)), 1u);
+  EXPECT_EQ(out[0], 'C');
+}
+
+TEST_F(UARTTest, ConcurrentChannels) {
+  constexpr size_t kBytes = 1 << 16;
+  const uint8_t numChannels = UART::getConfig().numChannels;
+  std::vector<char> ordered(numChannels, false);
+  std::vector<std::thread> threads;
+  for (uint8_t ch = 0; ch < numChannels; ++ch) {
+    threads.emplace_back([ch, &ordered] {
+      bool ok = true;
+      uint8_t buffer[8];
+      for (size_t sent = 0; sent < kBytes; sent += sizeof(buffer)) {
+        for (size_t i = 0; i < sizeof(buffer); ++i)
+          buffer[i] = static_cast<uint8_t>(sent + i + ch);
+        ok &= UART::writeBuffer(ch, buffer, sizeof(buffer)) == sizeof(buffer);
+        ok &= UART::drainTx(ch, buffer, sizeof(buffer)) == sizeof(buffer);
+        for (size_t i = 0; i < sizeof(buffer); ++i)
+          ok &= buffer[i] == static_cast<uint8_t>(sent + i + ch);
+      }
+      ordered[ch] = ok;
+    });
+  }
+  for (auto &thread : threads)
+    thread.join();
+
+  for (uint8_t ch = 0; ch < numChannels; ++ch)
+    EXPECT_TRUE(ordered[ch]) << "channel " << static_cast<int>(ch);
+}
+
+TEST_F(UARTTest, TimingPacesTransmit) {
+  ASSERT_TRUE(UART::initialize(1, 9600));
+  ASSERT_TRUE(UART::enableTiming(1)); // 8N1: 10 bits, ~1.04 ms per byte
+  EXPECT_TRUE(UART::isTimingEnabled(1));
+
+  const uint8_t data[] = {1, 2, 3, 4, 5};
+  auto start = Clock::now();
+  EXPECT_EQ(UART::writeBuffer(1, data, sizeof(data)), 5u);
+  uint8_t out[8];
+  EXPECT_EQ(UART::drainTx(1, out, sizeof(out)), 0u);
+
+  EXPECT_EQ(drainFor(1, 5, std::chrono::seconds(2)), 5u);
+  EXPECT_GE(Clock::now() - start, std::chrono::microseconds(5000));
+
+  UART::disableTiming(1);
+  EXPECT_TRUE(UART::write(1, 6));
+  EXPECT_EQ(UART::drainTx(1, out, sizeof(out)), 1u);
+}
+
+TEST_F(UARTTest, TimingChangesKeepRxOrder) {
+  UARTConfig config = UART::getConfig();
+  config.rxBufferSize = 64 * 1024;
+  UART::configure(config);
+  ASSERT_TRUE(UART::initialize(2, 921600));
+
+  // The injector keeps feeding RX while timing is switched on and off;
+  // bytes flushed from the line must not interleave with injected ones
+  constexpr size_t kBytes = 20000;
+  std::atomic<bool> done{false};
+  std::thread injector([&done] {
+    size_t sent = 0;
+    while (sent < kBytes) {
+      uint8_t chunk[16];
+      size_t count = std::min(sizeof(chunk), kBytes - sent);
+      for (size_t i = 0; i < count; ++i)
+        chunk[i] = static_cast<uint8_t>(sent + i);
+      sent += UART::injectRx(2, chunk, count);
+      std::this_thread::yield();
+    }
+    done = true;
+  });
+  while (!done) {
+    UART::enableTiming(2);
+    std::this_thread::yield();
+    UART::disableTiming(2);
+  }
+  injector.join();
+
+  std::vector<uint8_t> received(kBytes + 1);
+  ASSERT_EQ(UART::readBuffer(2, received.data(), received.size()), kBytes);
+  for (size_t i = 0; i < kBytes; ++i)
+    ASSERT_EQ(received[i], static_cast<uint8_t>(i)) << "byte " << i;
+  EXPECT_EQ(UART::getStats(2).rxOverflows, 0u);
+}
+
+TEST_F(UARTTest, TimingRaisesInterrupts) {
+  std::atomic<int> txDone{0};
+  std::atomic<int> rxReady{0};
+  auto &interrupts = InterruptManager::getInstance();
+  interrupts.attachInterrupt(InterruptType::UART_TX, 2,
+                             [&txDone] { ++txDone; });
+  interrupts.attachInterrupt(InterruptType::UART_RX, 2,
+                             [&rxReady] { ++rxReady; });
+  interrupts.start();
+
+  ASSERT_TRUE(UART::initialize(2, 921600));
+  ASSERT_TRUE(UART::enableTiming(2));
+  const uint8_t data[] = {'h', 'i'};
+  UART::writeBuffer(2, data, sizeof(data));
+  UART::injectRx(2, data, sizeof(data));
+
+  auto deadline = Clock::now() + std::chrono::seconds(2);
+  while ((txDone < 1 || rxReady < 1) && Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  interrupts.stop();
+  interrupts.detachInterrupt(InterruptType::UART_TX, 2);
+  interrupts.detachInterrupt(InterruptType::UART_RX, 2);
+
+  EXPECT_GE(txDone, 1);
+  EXPECT_GE(rxReady, 1);
+  uint8_t out[4];
+  EXPECT_EQ(UART::readBuffer(2, out, sizeof(out)), 2u);
+}
+
+TEST_F(UARTTest, FlowControlHoldsBytes) {
+  UARTConfig config = UART::getConfig();
+  config.hasFlowControl = true;
+  UART::configure(config);
+  ASSERT_TRUE(UART::initialize(0, 921600));
+  ASSERT_TRUE(UART::enableTiming(0));
+
+  // RTS: the RX buffer holds 16 bytes, the rest waits on the line
+  std::vector<uint8_t> data(16, 0x5A);
+  EXPECT_EQ(UART::injectRx(0, data.data(), data.size()), 16u);
+  auto deadline = Clock::now() + std::chrono::seconds(2);
+  while (UART::getStats(0).rxPending < 16 && Clock::now() < deadline)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  EXPECT_EQ(UART::injectRx(0, data.data(), 4), 4u);
+  std::this_thread::sleep_for(std::chrono::milliseconds(2));
+
+  uint8_t out[32];
+  EXPECT_EQ(UART::readBuffer(0, out, sizeof(out)), 16u);
+  deadline = Clock::now() + std::chrono::seconds(2);
+  size_t rest = 0;
+  while (rest < 4 && Clock::now() < deadline) {
+    rest += UART::readBuffer(0, out, sizeof(out));
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+  }
+  EXPECT_EQ(rest, 4u);
+  EXPECT_EQ(UART::getStats(0).rxOverflows, 0u);
+
+  // CTS: nothing is transmitted while deasserted
+  EXPECT_TRUE(UART::setCts(0, false));
+  EXPECT_TRUE(UART::write(0, 0x42));
+  EXPECT_EQ(drainFor(0, 1, std::chrono::milliseconds(5)), 0u);
+  EXPECT_TRUE(UART::setCts(0, true));
+  EXPECT_EQ(drainFor(0, 1, std::chrono::seconds(2)), 1u);
+
+  config.hasFlowControl = false;
+  UART::configure(config);
+}
\ No newline at end of file
@@ -0,0 +1,113 @@
+#include "sdk/gpio.hpp"
+#include "sdk/scheduler.hpp"
+#include "sdk/waveform.hpp"
+#include <chrono>
+#include <gtest/gtest.h>
+#include <thread>
+
+
+using namespace ti_sdk;
+
+class WaveformTest : public ::testing::Test {
+protected:
+  void SetUp() override { GPIO::initialize(); }
+
+  void TearDown() override {
+    WaveformGenerator::stopAll();
+    GPIO::initialize();
+  }
+
+  // Wait until a pin reaches a level, or give up after a timeout
+  static bool waitForLevel(uint8_t port, uint8_t pin, PinState level) {
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (std::chrono::steady_clock::now() < deadline) {
+      if (GPIO::readPin(port, pin) == level)
+        return true;
+      std::this_thread::yield();
+    }
+    return false;
+  }
+};
+
+TEST_F(WaveformTest, RejectsInputPins) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::INPUT));
+  EXPECT_FALSE(WaveformGenerator::startPWM(1, 0, 1000, 0.5));
+  EXPECT_FALSE(WaveformGenerator::startPattern(1, 0, 1000, {true, false}));
+}
+
+TEST_F(WaveformTest, PWMTogglesPin) {
+  EXPECT_TRUE(GPIO::configurePin(1, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(WaveformGenerator::startPWM(1, 0, 1000, 0.5));
+  EXPECT_TRUE(WaveformGenerator::isRunning(1, 0));
+
+  EXPECT_TRUE(waitForLevel(1, 0, PinState::HIGH));
+  EXPECT_TRUE(waitForLevel(1, 0, PinState::LOW));
+  EXPECT_TRUE(waitForLevel(1, 0, PinState::HIGH));
+
+  EXPECT_TRUE(WaveformGenerator::stop(1, 0));
+  EXPECT_FALSE(WaveformGenerator::isRunning(1, 0));
+  EXPECT_GT(WaveformGenerator::getStats().events, 0u);
+}
+
+TEST_F(WaveformTest, PWMPinsShareGenerator) {
+  EXPECT_TRUE(GPIO::configurePin(2, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(2, 1, PinMode::OUTPUT));
+  EXPECT_TRUE(WaveformGenerator::startPWM(2, 0, 10, 0.5));
+  EXPECT_TRUE(WaveformGenerator::startPWM(2, 1, 10, 0.5));
+
+  // Both pins follow the same 100 ms period in phase
+  EXPECT_TRUE(waitForLevel(2, 0, PinState::LOW));
+  EXPECT_EQ(GPIO::readPort(2) & 0b11, 0u);
+  EXPECT_TRUE(waitForLevel(2, 0, PinState::HIGH));
+  EXPECT_EQ(GPIO::readPort(2) & 0b11, 0b11u);
+}
+
+TEST_F(WaveformTest, PatternRunsOnce) {
+  EXPECT_TRUE(GPIO::configurePin(1, 3, PinMode::OUTPUT));
+  EXPECT_TRUE(WaveformGenerator::startPattern(1, 3, 10000,
+                                              {true, false, true, true},
+                                              false));
+
+  auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+  while (WaveformGenerator::isRunning(1, 3) &&
+         std::chrono::steady_clock::now() < deadline) {
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  }
+  EXPECT_FALSE(WaveformGenerator::isRunning(1, 3));
+  EXPECT_EQ(GPIO::readPin(1, 3), PinState::HIGH); // Last bit of the pattern
+}
+
+TEST_F(WaveformTest, ReusedSlotStartsInPhase) {
+  EXPECT_TRUE(GPIO::configurePin(1, 4, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(3, 0, PinMode::OUTPUT));
+  EXPECT_TRUE(GPIO::configurePin(3, 1, PinMode::OUTPUT));
+
+  for (int i = 0; i < 20; ++i) {
+    // Leave a freed slot whose last level was high
+    EXPECT_TRUE(WaveformGenerator::startPattern(1, 4, 100000, {true}, false));
+    auto deadline = std::chrono::steady_clock::now() + std::chrono::seconds(2);
+    while (WaveformGenerator::isRunning(1, 4) &&
+           std::chrono::steady_clock::now() < deadline) {
+      std::this_thread::yield();
+    }
+    ASSERT_FALSE(WaveformGenerator::isRunning(1, 4));
+
+    // A pin joining the new generator before its first edge must not pick
+    // up the stale level
+    EXPECT_TRUE(GPIO::writePortMasked(3, 0b11, 0));
+    EXPECT_TRUE(WaveformGenerator::startPWM(3, 0, 10, 0.5));
+    EXPECT_TRUE(WaveformGenerator::startPWM(3, 1, 10, 0.5));
+    uint32_t level = GPIO::readPort(3) & 0b11;
+    EXPECT_TRUE(level == 0 || level == 0b11) << "iteration " << i;
+    WaveformGenerator::stopAll();
+  }
+}
+
+TEST_F(WaveformTest, EdgesRunOnTimerScheduler) {
+  EXPECT_TRUE(GPIO::configurePin(1, 3, PinMode::OUTPUT));
+  uint64_t before = TimerScheduler::getStats().callbacks;
+  EXPECT_TRUE(WaveformGenerator::startPWM(1, 3, 1000, 0.5));
+  EXPECT_TRUE(waitForLevel(1, 3, PinState::HIGH));
+  EXPECT_TRUE(waitForLevel(1, 3, PinState::LOW));
+  EXPECT_GT(TimerScheduler::getStats().callbacks, before);
+}
\ No newline at end of file